@@ -16,6 +16,7 @@ struct Settings {
     std::vector<std::string> avoidVertices;             // vertices to avoid in any path
     std::vector<std::string> avoidEdges;                // edges to avoid in any path (even number of vertex addresses)
     std::vector<rose_addr_t> summarizeFunctions;        // functions to summarize
+    std::string summaryDatabase;                        // file holding function summaries reused across runs
     size_t maxRecursionDepth;                           // max recursion depth when expanding function calls
     size_t maxCallDepth;                                // max function call depth when expanding function calls
     size_t maxPathLength;                               // maximum length of any path considered
@@ -14,6 +14,7 @@
 #include <sstream>
 #include <list>
 #include <vector>
+#include <map>
 
 #include <omp.h>
 
@@ -205,6 +206,14 @@ namespace CodeThorn {
         not supported yet) */
     void setOptionContextSensitiveAnalysis(bool flag);
     bool getOptionContextSensitiveAnalysis();
+    /** allows to enable state subsumption. A new estate is not added
+        if an existing estate with the same label, call string,
+        constraints, and io approximates its pstate. */
+    void setOptionStateSubsumption(bool flag);
+    bool getOptionStateSubsumption();
+    long getNumberOfSubsumedEStates();
+    // number of estates removed from the subsumption index because a new estate subsumes them
+    long getNumberOfEvictedEStates();
 
     enum GlobalTopifyMode {GTM_IO, GTM_IOCF, GTM_IOCFPTR, GTM_COMPOUNDASSIGN, GTM_FLAGS};
     void setGlobalTopifyMode(GlobalTopifyMode mode);
@@ -408,6 +417,29 @@ namespace CodeThorn {
     std::vector<string> _commandLineOptions;
     SgTypeSizeMapping _typeSizeMapping;
     bool _contextSensitiveAnalysis;
+
+    // estates at one label with the same constraints, io and call string can subsume each other
+    struct SubsumptionKey {
+      SubsumptionKey(const EState& estate);
+      bool operator<(const SubsumptionKey& other) const;
+      const ConstraintSet* constraints; // constraint sets are unique, compared by address
+      InputOutput io;
+      CallString callString;
+    };
+    // the estates at one label that are not subsumed by another estate, with a lock per label
+    struct SubsumptionBucket {
+      SubsumptionBucket();
+      ~SubsumptionBucket();
+      omp_lock_t lock;
+      std::map<SubsumptionKey, std::list<const EState*> > estates;
+    };
+    void initializeSubsumptionIndex();
+    void deleteSubsumptionIndex();
+    bool _stateSubsumption;
+    long _numberOfSubsumedEStates;
+    long _numberOfEvictedEStates;
+    // indexed by label id (only maintained with state subsumption)
+    std::vector<SubsumptionBucket*> _subsumptionIndex;
   }; // end of class Analyzer
 } // end of namespace CodeThorn
 
@@ -7,7 +7,7 @@
 namespace CodeThorn {
   class CTIOLabeler : public SPRAY::IOLabeler {
   public:
-    CTIOLabeler(SgNode* start, SPRAY::VariableIdMapping* variableIdMapping);
+    CTIOLabeler(SgNode* start, SPRAY::VariableIdMapping* variableIdMapping, size_t numberOfThreads=1);
     virtual bool isStdIOLabel(SPRAY::Label label);
     virtual bool isStdInLabel(SPRAY::Label label, SPRAY::VariableId* id);
     bool isNonDetIntFunctionCall(SPRAY::Label lab,SPRAY::VariableId* varIdPtr);
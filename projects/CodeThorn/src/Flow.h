@@ -15,6 +15,8 @@ namespace SPRAY {
   class Edge;
   typedef std::set<Edge> EdgeSet;
   typedef std::set<EdgeType> EdgeTypeSet;
+  // bit mask of edge types (bit i is set for EdgeType i)
+  typedef unsigned int EdgeTypeMask;
   
 #ifdef USE_SAWYER_GRAPH
   struct EdgeData {
@@ -50,6 +52,7 @@ namespace SPRAY {
     void addTypes(std::set<EdgeType> ets);
     void removeType(EdgeType et);
     EdgeTypeSet types() const;
+    EdgeTypeMask typesMask() const;
     long typesCode() const;
     std::string color() const;
     std::string dotEdgeStyle() const;
@@ -159,6 +162,19 @@ namespace SPRAY {
     void setDotFixedNodeColor(std::string color);
     void setDotOptionHeaderFooter(bool opt);
     std::string toDot(Labeler *labeler);
+
+    //! builds a compact adjacency index of the current edges: in- and out-edges are stored in
+    //! compressed rows indexed by the dense label id, with an edge type mask for each edge.
+    //! While the flow is frozen, inEdges, outEdges, pred, succ, outEdgesOfType and contains(Label)
+    //! are answered from the index. Inserting or erasing edges discards the index, edge types
+    //! changed with iterator::setTypes require calling freeze again. Queries on a frozen flow can
+    //! run concurrently, freeze itself must not.
+    void freeze();
+    bool isFrozen() const { return _frozen; }
+    typedef std::vector<Edge>::const_iterator const_edge_iterator;
+    //! out-edges and in-edges of a label, the flow must be frozen.
+    boost::iterator_range<const_edge_iterator> frozenOutEdges(Label label) const;
+    boost::iterator_range<const_edge_iterator> frozenInEdges(Label label) const;
     void setTextOptionPrintType(bool opt);
     void resetDotOptions();
     std::string toString();
@@ -180,6 +196,14 @@ namespace SPRAY {
     std::string _fixedNodeColor;
     bool _dotOptionHeaderFooter;
     Label _startLabel;
+    void unfreeze();
+    bool _frozen;
+    // frozen adjacency index: edges of label l are at [offsets[l],offsets[l+1]) of the edge vectors
+    std::vector<size_t> _frozenOutOffsets;
+    std::vector<Edge> _frozenOutEdges;
+    std::vector<EdgeTypeMask> _frozenOutTypes;
+    std::vector<size_t> _frozenInOffsets;
+    std::vector<Edge> _frozenInEdges;
 #ifdef USE_SAWYER_GRAPH
     SawyerCfg  _sawyerFlowGraph;
 #else
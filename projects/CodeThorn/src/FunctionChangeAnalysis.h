@@ -0,0 +1,121 @@
+#ifndef FUNCTION_CHANGE_ANALYSIS_H
+#define FUNCTION_CHANGE_ANALYSIS_H
+
+#include <string>
+#include <map>
+#include <set>
+#include <vector>
+#include "Labeler.h"
+#include "Flow.h"
+
+/*!
+  * \brief Side-effect summary diff between two runs.
+  *
+  * Each function definition is identified by its file name and mangled
+  * name and is summarized by a hash of its unparsed source code. The
+  * summary of a function is the set of non-local variables (globals,
+  * namespace variables, static variables) it may modify and reference,
+  * either directly or through the functions it calls. Accesses through
+  * pointers and to non-static members are not tracked, and functions
+  * without a definition are assumed not to access program variables.
+  *
+  * The hashes, callees and summaries of a run are saved to a state file.
+  * A later run loads that file and determines the changed functions:
+  * those that were added or modified and those whose set of callees
+  * changed. A function is affected if it is changed or if it is a
+  * transitive caller of a changed function. The summaries of affected
+  * functions are recomputed bottom-up over the call graph (strongly
+  * connected components, callees first); the summaries of all other
+  * functions are taken from the state file.
+  *
+  * Only the side-effect summaries are computed incrementally. The affected
+  * set says nothing about the results of other analyses (e.g. interval,
+  * live variables, reaching definitions), which depend on labels that are
+  * not stable between runs, and must not be used to skip them.
+  *
+  * Indirect calls (through function pointers and to virtual functions)
+  * are assumed to call every function whose address is taken and every
+  * virtual function.
+  *
+  * \date 2026.
+ */
+
+namespace SPRAY {
+class FunctionChangeAnalysis {
+ public:
+  struct FunctionSummary {
+    std::set<std::string> mod;
+    std::set<std::string> ref;
+    bool operator==(const FunctionSummary& other) const;
+    bool operator!=(const FunctionSummary& other) const;
+  };
+  FunctionChangeAnalysis();
+  // computes the hash of each function definition and the call graph from the inter-flow
+  void computeFunctionHashes(SgProject* root);
+  void computeCallGraph(Labeler* labeler, InterFlow& interFlow);
+  // reads the state of a previous run. Returns false if the file does not exist.
+  bool readStateFile(std::string fileName);
+  void writeStateFile(std::string fileName);
+  // compares current and previous state, determines the affected functions (changed functions
+  // and all their transitive callers) and computes their summaries. The summaries of all other
+  // functions are taken from the previous state.
+  void computeAffectedFunctions();
+
+  bool isAffected(SgFunctionDefinition* funDef);
+  std::set<SgFunctionDefinition*> getAffectedFunctions();
+  // all function definitions, ordered by key
+  std::vector<SgFunctionDefinition*> getFunctions();
+  FunctionSummary getSummary(SgFunctionDefinition* funDef);
+  std::set<SgFunctionDefinition*> getCallees(SgFunctionDefinition* funDef);
+  size_t numFunctions();
+  size_t numAddedFunctions();
+  size_t numModifiedFunctions();
+  size_t numRemovedFunctions();
+  size_t numAffectedFunctions();
+  size_t numReusableFunctions();
+  std::string statisticsToString();
+  // writes one line "function,mod|ref,variable" for each entry of each summary
+  void writeSummaryCsvFile(std::string fileName);
+
+  static std::string functionKey(SgFunctionDefinition* funDef);
+  // 64-bit FNV-1a hash of the unparsed function, printed in hex. Stable across runs.
+  static std::string functionHash(SgFunctionDefinition* funDef);
+  // true if the call is made through a function pointer or to a virtual function
+  static bool isIndirectCall(SgFunctionCallExp* funCall);
+ private:
+  struct PreviousState {
+    std::string hash;
+    std::set<std::string> callees;
+    FunctionSummary summary;
+  };
+  // adds the non-local variables accessed in the body of funDef to summary
+  void computeDirectEffects(SgFunctionDefinition* funDef, FunctionSummary& summary);
+  std::vector<std::vector<SgFunctionDefinition*> > stronglyConnectedComponents();
+  void strongConnect(SgFunctionDefinition* funDef,
+                     std::map<SgFunctionDefinition*,size_t>& index,
+                     std::map<SgFunctionDefinition*,size_t>& lowLink,
+                     std::vector<SgFunctionDefinition*>& stack,
+                     std::set<SgFunctionDefinition*>& onStack,
+                     std::vector<std::vector<SgFunctionDefinition*> >& components);
+  std::set<std::string> calleeKeys(SgFunctionDefinition* funDef);
+  // adds the changed functions and all their transitive callers to _affected
+  void markTransitiveCallers(const std::set<SgFunctionDefinition*>& changed);
+
+  std::map<std::string,SgFunctionDefinition*> _functions;
+  std::map<SgFunctionDefinition*,std::string> _keys;
+  std::map<std::string,std::string> _currentHashes;
+  std::map<std::string,PreviousState> _previousState;
+  // targets of indirect calls: functions whose address is taken and virtual functions
+  std::set<SgFunctionDefinition*> _indirectCallTargets;
+  // directed call graph: for each function its callees
+  std::map<SgFunctionDefinition*,std::set<SgFunctionDefinition*> > _callees;
+  std::map<SgFunctionDefinition*,FunctionSummary> _summaries;
+  std::set<SgFunctionDefinition*> _affected;
+  bool _previousStateAvailable;
+  size_t _numAdded;
+  size_t _numModified;
+  size_t _numRemoved;
+};
+} // end of namespace SPRAY
+
+#endif
@@ -61,6 +61,9 @@ namespace CodeThorn {
     void writeToMemoryLocation(AbstractValue abstractMemLoc,
                                AbstractValue abstractValue);
     size_t stateSize() const;
+    // true if every state represented by this state is also represented by 'other', i.e. both
+    // states bind the same memory locations and every value is equal to or less precise in 'other'
+    bool isApproximatedBy(const PState& other) const;
     PState::iterator begin();
     PState::iterator end();
     PState::const_iterator begin() const;
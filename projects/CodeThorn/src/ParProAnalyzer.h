@@ -41,6 +41,7 @@ namespace CodeThorn {
     ParProAnalyzer();
     ParProAnalyzer(std::vector<Flow*> cfas);
     ParProAnalyzer(std::vector<Flow*> cfas, boost::unordered_map<int, int>& cfgIdToStateIndex);
+    ~ParProAnalyzer();
     void init(std::vector<Flow*> cfas);
     void init(std::vector<Flow*> cfas, boost::unordered_map<int, int>& cfgIdToStateIndex);
     void initializeSolver();
@@ -61,6 +62,7 @@ namespace CodeThorn {
     bool isPreciseTransition(Edge e, const ParProEState* eState);
     ParProEState setComponentToTerminationState(unsigned int i, const ParProEState* state);
     bool isIncompleteStgReady();
+    ParProEStateSet::ProcessingResult processEState(const ParProEState& estate);
     void addToWorkList(const ParProEState* estate);
     bool isEmptyWorkList();
     const ParProEState* popWorkList();
@@ -77,6 +79,12 @@ namespace CodeThorn {
     EdgeAnnotationMap _annotationToEdges;
     ComponentApproximation _approximation;
     vector<Label> _artificalTerminationLabels;
+    // guards the state set, worklist, transition graph and the solver's work vector
+    omp_lock_t _lock;
+
+    // not copyable (owns _lock)
+    ParProAnalyzer(const ParProAnalyzer&);
+    ParProAnalyzer& operator=(const ParProAnalyzer&);
   };
 
 } // end of namespace CodeThorn
@@ -48,6 +48,8 @@ namespace CodeThorn {
     // analyzes the behavior of the parallel program according to the selected options
     void explore();
     void computeStgApprox(ParallelSystem& system, ComponentApproximation approxMode);
+    // computes the given STGs, in parallel if more than one thread is used
+    void computeStgApprox(std::vector<std::pair<ParallelSystem*, ComponentApproximation> >& stgsToCompute);
     PropertyValueTable* propertyValueTable();
 
     void setComponentSelection(ComponentSelection componentSelection) { _componentSelection = componentSelection; }
@@ -77,6 +79,12 @@ namespace CodeThorn {
 
   private:
     ParallelSystem exploreOnce();
+    // selects the next numSystems systems and computes their STGs
+    std::list<ParallelSystem> exploreBatch(int numSystems);
+    // number of systems to explore at once, at most "remaining" (unlimited if negative)
+    int batchSize(int remaining);
+    ParProTransitionGraph* computeStg(ParallelSystem& system, ComponentApproximation approxMode);
+    void visualizeStgs(ParallelSystem& system);
     PropertyValueTable* ltlAnalysis(ParallelSystem system);
     std::set<int> randomSetNonNegativeInts(int size, int maxInt);
     void recalculateNumVerifiedFalsified();
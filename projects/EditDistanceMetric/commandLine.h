@@ -4,8 +4,11 @@
 struct Settings {
     double insertionCost, deletionCost, substitutionCost;
     bool useOldImplementation;
+    bool matchFunctions;
+    double minSimilarity;
     Settings()
-        : insertionCost(1.0), deletionCost(1.0), substitutionCost(1.0), useOldImplementation(true) {}
+        : insertionCost(1.0), deletionCost(1.0), substitutionCost(1.0), useOldImplementation(true), matchFunctions(false),
+          minSimilarity(0.5) {}
 };
 
 Sawyer::CommandLine::SwitchGroup toolCommandLineSwitches(Settings&);
@@ -202,6 +202,36 @@ class ChainComposer : public Composer, public UndirDataflow
   // adjacent in the chain, the number is 0).
   //static std::map<ComposedAnalysis*, std::map<reqType, int > > serverCache;
   
+  // Memoized results of Expr2Val and Expr2MemLoc queries. These queries are answered by analyses in
+  // doneAnalyses, which have finished running, so the answer for a given expression and PartEdge never
+  // changes. doneAnalyses is always a prefix of the chain (the syntactic analysis followed by allAnalyses),
+  // so its size identifies the analyses that could have answered. Callers may modify the objects they
+  // receive, so the cache holds its own copies and hands out fresh copies.
+  class QueryKey
+  {
+    public:
+    size_t nDone;
+    SgNode* n;
+    PartEdgePtr pedge;
+
+    QueryKey(size_t nDone, SgNode* n, PartEdgePtr pedge) : nDone(nDone), n(n), pedge(pedge) {}
+
+    bool operator<(const QueryKey& that) const {
+      if(nDone != that.nDone) return nDone < that.nDone;
+      if(n != that.n) return n < that.n;
+      return pedge < that.pedge;
+    }
+  };
+  std::map<QueryKey, ValueObjectPtr> expr2ValCache;
+  std::map<QueryKey, MemLocObjectPtr> expr2MemLocCache;
+  // Number of queries answered from the caches and number that had to go through the chain
+  size_t nCacheHits, nCacheMisses;
+
+  public:
+  // Discards all memoized query results
+  void clearQueryCache();
+
+  private:
   // Generic function that looks up the composition chain from the given client 
   // analysis and returns the result produced by the first instance of the function 
   // called by the caller object found along the way.
@@ -8,6 +8,9 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
 
 namespace dbglog {
 
@@ -171,6 +174,60 @@ class block
   virtual void printExit() {}
 };
 
+// A streambuf that writes to a base streambuf from a background thread. Text is collected into chunks of
+// chunkSize bytes and full chunks are handed to the writer thread through a queue that holds at most maxChunks
+// chunks. The thread that produces the text only blocks when the queue is full, so the amount of memory used
+// by pending output is bounded while the analysis does not wait on the file system for every line it logs.
+// Flushing waits until everything written so far has reached the base streambuf. All open asyncBufs are also
+// flushed at exit and when the process aborts, so a crash loses at most the text written after the abort began.
+class asyncBuf: public std::streambuf
+{
+  std::streambuf* baseBuf;
+  size_t chunkSize;
+  size_t maxChunks;
+  // The chunk currently being filled by the producer
+  std::string current;
+  // Full chunks waiting to be written, protected by mutex
+  std::list<std::string> pending;
+  // Number of chunks handed to the writer thread and number it has finished writing, protected by mutex
+  size_t nQueued;
+  size_t nWritten;
+  // Set when the writer thread should exit once the queue is empty
+  bool done;
+  boost::mutex mutex;
+  boost::condition_variable notEmpty;
+  boost::condition_variable notFull;
+  boost::condition_variable written;
+  boost::thread writer;
+
+  // All asyncBufs that have not been closed, so that they can be flushed at exit or abort
+  static std::set<asyncBuf*> openBufs;
+  static boost::mutex openMutex;
+
+  public:
+  asyncBuf(std::streambuf* baseBuf, size_t chunkSize=65536, size_t maxChunks=64);
+  ~asyncBuf();
+
+  // Writes out all the text written so far and stops the writer thread. No text may be written afterwards.
+  void close();
+
+  protected:
+  virtual int overflow(int c);
+  virtual std::streamsize xsputn(const char* s, std::streamsize n);
+  // Hands the current chunk to the writer thread and waits until all pending text has been written
+  virtual int sync();
+
+  private:
+  // Flushes every open asyncBuf; installed as an exit handler and a SIGABRT handler
+  static void flushAll();
+  static void flushAllOnAbort(int sig);
+
+  // Moves the current chunk to the queue, waiting while the queue is full
+  void enqueue();
+  // Body of the writer thread
+  void run();
+};
+
 // Adopted from http://wordaligned.org/articles/cpp-streambufs
 // A extension of stream that corresponds to a single file produced by dbglog
 class dbgBuf: public std::streambuf
@@ -257,6 +314,8 @@ class dbgStream : public std::ostream
 {
   std::list<std::ofstream*> indexFiles;
   std::list<std::ofstream*> dbgFiles;
+  // The background writers for the dbgFiles, one per file
+  std::list<asyncBuf*>      dbgFileBufs;
   std::list<std::string>    detailFileRelFNames; // Relative names of all the dbg files on the stack
   std::list<std::ofstream*> summaryFiles;
   std::list<std::ofstream*> scriptFiles;
@@ -3,6 +3,7 @@
 
 #include "sage3basic.h"
 #include "AstTerm.h"
+#include <unordered_map>
 
 namespace Typeforge {
 
@@ -12,12 +13,30 @@ class Analysis {
     int variableSetAnalysis(SgProject* project, SgType* matchType, bool base);
     void writeAnalysis(SgType* type, std::string toTypeString);
     void writeGraph(std::string fileName);
+    //Returns the set containing the node, or nullptr if the node is in no set. The set is owned by the analysis
+    //and is only valid until the next call to variableSetAnalysis, which may merge sets and rebuild them all.
     std::set<SgNode*>* getSet(SgNode* node);
   private:
     void linkVariables(SgNode* key, SgType* type, SgExpression* exp);
     void addToMap(SgNode* originNode, SgNode* targetNode);
+
+    //Union-find over dense node indices: connected variables end up with the same root.
+    size_t nodeId(SgNode* node);
+    size_t findRoot(size_t id);
+    void unite(size_t a, size_t b);
+    void materializeSets();
+    void clearSets();
+
+    std::unordered_map<SgNode*,size_t> nodeIds;
+    std::vector<SgNode*> nodes;                       //indexed by node id
+    std::vector<size_t> parents;                      //indexed by node id
+    std::vector<unsigned> ranks;                      //indexed by node id
+    std::vector<std::pair<size_t,size_t> > links;     //direct links, used only for the graph
+
+    //Sets are built from the union-find on first use and discarded whenever another union happens.
+    bool setsValid;
     std::list<std::set<SgNode*>*> listSets;
-    std::map<SgNode*,std::set<SgNode*>*> setMap;
+    std::vector<std::set<SgNode*>*> setOfRoot;        //indexed by node id of the root
 };
 
 }
@@ -13,6 +13,9 @@
 #define  MOD_FILE_SUFFIX   ".rmod"
 #define  SKIP_SYNTAX_CHECK "-rose:skip_syntax_check"
 
+#include <ctime>
+#include <stdint.h>
+
 // DQ (10/11/2010): Never use using declarations in a header file since
 // they apply to the whole translation unit and have global effects.
 // using std::vector;
@@ -24,11 +27,44 @@ class FortranModuleInfo
      private:
        static SgProject*                      currentProject;
 
+    // Modification time and size of an rmod file, used to notice that it was regenerated after it was read.
+       struct RmodFileStamp
+          {
+            std::time_t timestamp;
+            uintmax_t   size;
+
+            RmodFileStamp() : timestamp(0), size(0) {}
+            bool operator==(const RmodFileStamp & x) const
+               { return timestamp == x.timestamp && size == x.size; }
+            bool operator!=(const RmodFileStamp & x) const { return !(*this == x); }
+          };
+
+    // A module read from an rmod file, along with the file it came from and that file's stamp.  Once read, a
+    // module is used by every later compilation unit in the same process, even if its rmod file is regenerated:
+    // use statements that were already processed refer to the module's declarations and symbols, so replacing
+    // it would leave two inconsistent copies in one AST.  A changed rmod file only produces a warning.  Modules
+    // are not reused across processes: each invocation of ROSE parses the rmod files it needs once.
+       struct ModuleCacheEntry
+          {
+            SgModuleStatement* moduleStatement;
+            std::string        rmodFileName;
+            RmodFileStamp      stamp;
+            bool               stampMismatchReported;
+
+            ModuleCacheEntry() : moduleStatement(NULL), stampMismatchReported(false) {}
+            ModuleCacheEntry(SgModuleStatement* m, const std::string & n, const RmodFileStamp & s)
+               : moduleStatement(m), rmodFileName(n), stamp(s), stampMismatchReported(false) {}
+          };
+
     // DQ (10/1/2010): Added a typedef to simplify code using the moduleNameAstMap data member.
     // static map<string, SgModuleStatement*> moduleNameAstMap;
-       typedef std::map<std::string, SgModuleStatement*> ModuleMapType;
+       typedef std::map<std::string, ModuleCacheEntry> ModuleMapType;
        static ModuleMapType moduleNameAstMap;
 
+    // Number of module lookups satisfied by the map and number that required reading an rmod file.
+       static size_t nCacheHits;
+       static size_t nCacheMisses;
+
        static unsigned int             nestedSgFile; 
        static std::vector<std::string> inputDirs   ;
 
@@ -42,6 +78,10 @@ class FortranModuleInfo
 
        static std::string find_file_from_inputDirs(std::string name);
 
+    // Number of module lookups satisfied without reading an rmod file, and the number that read one.
+       static size_t getCacheHits();
+       static size_t getCacheMisses();
+
        static void set_inputDirs(SgProject* );
  
        FortranModuleInfo(){};
@@ -52,6 +92,7 @@ class FortranModuleInfo
        static SgSourceFile*  createSgSourceFile(std::string modName);
        static void           clearMap();
        static void           dumpMap();
+       static RmodFileStamp  rmodFileStamp(const std::string & rmodFileName);
 
   };
 
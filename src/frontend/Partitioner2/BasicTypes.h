@@ -164,6 +164,17 @@ public:
         s.copyAllInstructions = true;               // true keeps the AST a tree instead of a lattice
         return s;
     }
+
+    /** Default settings for building one function at a time.
+     *
+     *  These are the @ref strict settings except instructions are not copied: the basic blocks in the AST point to the same
+     *  instruction nodes as the partitioner's instruction provider. This saves time and memory when function ASTs are built
+     *  and released one at a time (see @ref Modules::buildFunctionAsts). */
+    static AstConstructionSettings streaming() {
+        AstConstructionSettings s = strict();
+        s.copyAllInstructions = false;
+        return s;
+    }
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -345,6 +356,7 @@ struct PartitionerSettings {
     bool findingCodeFunctionPointers;               /**< Look for function pointers in instructions. */
     bool findingThunks;                             /**< Look for common thunk patterns in undiscovered areas. */
     bool splittingThunks;                           /**< Split thunks into their own separate functions. */
+    bool deferringSwitchResolution;                 /**< Resolve "switch" statements in batches after discovery. */
     SemanticMemoryParadigm semanticMemoryParadigm;  /**< Container used for semantic memory states. */
     bool namingConstants;                           /**< Give names to constants by calling @ref Modules::nameConstants. */
     bool namingStrings;                             /**< Give labels to constants that are string literal addresses. */
@@ -403,6 +415,8 @@ private:
         s & BOOST_SERIALIZATION_NVP(namingConstants);
         s & BOOST_SERIALIZATION_NVP(namingStrings);
         s & BOOST_SERIALIZATION_NVP(demangleNames);
+        if (version >= 6)
+            s & BOOST_SERIALIZATION_NVP(deferringSwitchResolution);
         if (version >= 1) {
             s & BOOST_SERIALIZATION_NVP(namingSyscalls);
 
@@ -426,8 +440,9 @@ public:
           doingPostAnalysis(true), doingPostFunctionMayReturn(true), doingPostFunctionStackDelta(true),
           doingPostCallingConvention(false), doingPostFunctionNoop(false), functionReturnAnalysis(MAYRETURN_DEFAULT_YES),
           functionReturnAnalysisMaxSorts(50), findingDataFunctionPointers(false), findingCodeFunctionPointers(false),
-          findingThunks(true), splittingThunks(false), semanticMemoryParadigm(LIST_BASED_MEMORY), namingConstants(true),
-          namingStrings(true), namingSyscalls(true), demangleNames(true) {}
+          findingThunks(true), splittingThunks(false), deferringSwitchResolution(false),
+          semanticMemoryParadigm(LIST_BASED_MEMORY), namingConstants(true), namingStrings(true), namingSyscalls(true),
+          demangleNames(true) {}
 };
 
 // BOOST_CLASS_VERSION(PartitionerSettings, 1); -- see end of file (cannot be in a namespace)
@@ -469,6 +484,6 @@ typedef Sawyer::SharedPointer<ThunkPredicates> ThunkPredicatesPtr;
 } // namespace
 
 // Class versions must be at global scope
-BOOST_CLASS_VERSION(Rose::BinaryAnalysis::Partitioner2::PartitionerSettings, 5);
+BOOST_CLASS_VERSION(Rose::BinaryAnalysis::Partitioner2::PartitionerSettings, 6);
 
 #endif
@@ -8,6 +8,7 @@
 #include <FileSystem.h>
 #include <Partitioner2/Function.h>
 #include <Partitioner2/ModulesLinux.h>
+#include <Partitioner2/ModulesX86.h>
 #include <Partitioner2/Partitioner.h>
 #include <Partitioner2/Thunk.h>
 #include <Partitioner2/Utility.h>
@@ -239,6 +240,7 @@ private:
     CodeConstants::Ptr codeFunctionPointers_;           // generates constants that are found in instruction ASTs
     Progress::Ptr progress_;                            // optional progress reporting
     ModulesLinux::LibcStartMain::Ptr libcStartMain_;    // looking for "main" by analyzing libc_start_main?
+    ModulesX86::DeferredSwitchResolver::Ptr switchResolver_; // resolves "switch" statements after discovery if deferring
     ThunkPredicates::Ptr functionMatcherThunks_;        // predicates to find thunks when looking for functions
     ThunkPredicates::Ptr functionSplittingThunks_;      // predicates for splitting thunks from front of functions
 
@@ -758,6 +760,16 @@ public:
      *  to implement a more directed approach to discovering basic blocks. */
     virtual void discoverBasicBlocks(Partitioner&);
 
+    /** Resolve deferred "switch" statements.
+     *
+     *  If @ref deferringSwitchResolution is set, then examine all basic blocks whose "switch" statements have not been resolved
+     *  yet and replace their indeterminate successors with the case labels (see @ref ModulesX86::DeferredSwitchResolver).
+     *  Returns the number of blocks that were changed, in which case new basic blocks need to be discovered.  This is called by
+     *  @ref discoverBasicBlocks each time it runs out of blocks, so every path that discovers blocks (including those that
+     *  create functions, attach dead code, or split thunks) also resolves them.  Returns zero if switch resolution is not
+     *  being deferred. */
+    virtual size_t resolveDeferredSwitches(Partitioner&);
+
     /** Scan read-only data to find function pointers.
      *
      *  Scans read-only data beginning at the specified address in order to find pointers to code, and makes a new function at
@@ -892,7 +904,8 @@ public:
     /** Attach basic blocks to functions.
      *
      *  Calls @ref Partitioner::discoverFunctionBasicBlocks once for each known function the partitioner's CFG/AUM in a
-     *  sophomoric attempt to assign existing basic blocks to functions. */
+     *  sophomoric attempt to assign existing basic blocks to functions.  If @ref deferringSwitchResolution is set then any
+     *  unresolved "switch" statements are resolved and their cases discovered first (see @ref resolveDeferredSwitches). */
     virtual void attachBlocksToFunctions(Partitioner&);
 
     /** Attach dead code to functions.
@@ -1238,6 +1251,19 @@ public:
     virtual void splittingThunks(bool b) { settings_.partitioner.splittingThunks = b; }
     /** @} */
 
+    /** Property: Whether to resolve "switch" statements in batches.
+     *
+     *  If clear, then each basic block that ends with an x86 indirect jump is examined for a jump table as soon as it is
+     *  discovered (see @ref ModulesX86::SwitchSuccessors). If set, then those blocks are left with indeterminate successors
+     *  during discovery and are examined in batches, in parallel, each time discovery runs out of blocks to discover (see
+     *  @ref resolveDeferredSwitches and @ref ModulesX86::DeferredSwitchResolver). This setting must be adjusted before the
+     *  partitioner is created.
+     *
+     * @{ */
+    bool deferringSwitchResolution() const /*final*/ { return settings_.partitioner.deferringSwitchResolution; }
+    virtual void deferringSwitchResolution(bool b) { settings_.partitioner.deferringSwitchResolution = b; }
+    /** @} */
+
     /** Property: Predicate for finding thunks at the start of functions.
      *
      *  This collective predicate is used when searching for thunks at the beginnings of existing functions in order to split
@@ -0,0 +1,181 @@
+#ifndef ROSE_BinaryAnalysis_Partitioner2_FunctionAnalysisScheduler_H
+#define ROSE_BinaryAnalysis_Partitioner2_FunctionAnalysisScheduler_H
+
+#include <Partitioner2/BasicTypes.h>
+#include <Partitioner2/Function.h>
+#include <BinaryCallingConvention.h>
+#include <Sawyer/Graph.h>
+#include <ostream>
+#include <vector>
+
+namespace Rose {
+namespace BinaryAnalysis {
+namespace Partitioner2 {
+
+/** Runs whole-program function analyses concurrently.
+ *
+ *  The partitioner has a number of per-function analyses that are run after partitioning, such as stack delta analysis, calling
+ *  convention analysis, and no-op analysis. Each of them has an "all functions" form (e.g., @ref
+ *  Partitioner::allFunctionStackDelta) that builds its own call graph and runs the analysis in parallel with callees before
+ *  callers, and there's an implied barrier between one analysis and the next.
+ *
+ *  This scheduler instead builds a single dependency graph whose tasks are (function, analysis) pairs. The call graph is computed
+ *  and made acyclic once and the same dependencies are used for every analysis. Because the dependencies between analyses are
+ *  also per function, tasks from different analyses overlap: the calling convention analysis of a function can start as soon as
+ *  the stack deltas of that function and its callees are known even if the stack delta analysis is still running for unrelated
+ *  functions.
+ *
+ *  The scheduler records when each task started and finished so that a timeline and the critical path (the longest chain of
+ *  dependent tasks) can be reported after the run.
+ *
+ *  Results are cached in the function objects exactly as if the individual "all functions" analyses had been run, so calling
+ *  those methods afterward is cheap.  The steps that normally follow those analyses can also be done by the scheduler so that
+ *  they don't need another pass over the call graph: see @ref namingNoopFunctions and @ref assigningCallingConventions. */
+class FunctionAnalysisScheduler {
+public:
+    /** Analyses known to the scheduler. */
+    enum Analysis {
+        ANALYZE_NOOP,                                   /**< Function no-op analysis. See @ref Partitioner::functionIsNoop. */
+        ANALYZE_STACK_DELTA,                            /**< Stack delta analysis. See @ref Partitioner::functionStackDelta. */
+        ANALYZE_CALLING_CONVENTION,                     /**< Calling convention analysis. See @ref
+                                                         *   Partitioner::functionCallingConvention. */
+        N_ANALYSES                                      /**< Number of analyses. Not an analysis itself. */
+    };
+
+    /** One unit of work. */
+    struct Task {
+        Function::Ptr function;                         /**< Function being analyzed. */
+        Analysis analysis;                              /**< Analysis to run on the function. */
+
+        Task()
+            : analysis(ANALYZE_NOOP) {}
+        Task(const Function::Ptr &function, Analysis analysis)
+            : function(function), analysis(analysis) {}
+    };
+
+    /** When a task ran.
+     *
+     *  Times are in seconds measured from the start of @ref run. */
+    struct TaskTiming {
+        Task task;                                      /**< Task that was run. */
+        double started;                                 /**< Time at which the task started. */
+        double finished;                                /**< Time at which the task finished. */
+
+        TaskTiming()
+            : started(0.0), finished(0.0) {}
+
+        /** Elapsed time for the task. */
+        double duration() const { return finished - started; }
+    };
+
+    /** Dependencies among tasks.
+     *
+     *  An edge from task @em a to task @em b means @em a cannot start until @em b has finished. */
+    typedef Sawyer::Container::Graph<Task> DependencyGraph;
+
+private:
+    const Partitioner &partitioner_;
+    bool enabled_[N_ANALYSES];
+    CallingConvention::Definition::Ptr dfltCc_;
+    bool namingNoops_;                                  // name no-op functions as they're found
+    bool assigningCcDefs_;                              // assign calling convention definitions after the analysis
+    std::vector<TaskTiming> timeline_;                  // indexed by dependency graph vertex ID
+    std::vector<std::vector<size_t> > dependencies_;    // task IDs on which each task depends
+    double elapsed_;                                    // wall time for the whole run
+
+public:
+    /** Construct a scheduler for a partitioner.
+     *
+     *  No analyses are enabled initially. The partitioner must not be modified while the scheduler is running. */
+    explicit FunctionAnalysisScheduler(const Partitioner&);
+
+    /** Property: Whether an analysis is enabled.
+     *
+     * @{ */
+    bool isEnabled(Analysis a) const { return enabled_[a]; }
+    void enable(Analysis a, bool b = true) { enabled_[a] = b; }
+    /** @} */
+
+    /** Property: Default calling convention.
+     *
+     *  This is the convention assumed for callees whose calling convention is not yet known, which happens only where the call
+     *  graph had to be made acyclic. See @ref Partitioner::allFunctionCallingConvention.
+     *
+     * @{ */
+    CallingConvention::Definition::Ptr defaultCallingConvention() const { return dfltCc_; }
+    void defaultCallingConvention(const CallingConvention::Definition::Ptr &cc) { dfltCc_ = cc; }
+    /** @} */
+
+    /** Property: Whether to name no-op functions.
+     *
+     *  If set, then after all tasks have finished each function that the no-op analysis found to be a no-op and that has no
+     *  name is given a name, exactly as @ref Modules::nameNoopFunctions would. The names are not assigned by the tasks
+     *  themselves since other tasks may be analyzing the same function concurrently. Has no effect unless @ref ANALYZE_NOOP
+     *  is enabled.
+     *
+     * @{ */
+    bool namingNoopFunctions() const { return namingNoops_; }
+    void namingNoopFunctions(bool b) { namingNoops_ = b; }
+    /** @} */
+
+    /** Property: Whether to assign calling convention definitions.
+     *
+     *  If set, then the calling convention analysis task for a function also finds the architecture's calling convention
+     *  definitions that match the function, and when all tasks have finished each function's @ref
+     *  Function::callingConventionDefinition property is set to the most frequent of its matches, exactly as @ref
+     *  Partitioner::allFunctionCallingConventionDefinition would. Has no effect unless @ref ANALYZE_CALLING_CONVENTION is
+     *  enabled.
+     *
+     * @{ */
+    bool assigningCallingConventions() const { return assigningCcDefs_; }
+    void assigningCallingConventions(bool b) { assigningCcDefs_ = b; }
+    /** @} */
+
+    /** Build the task dependency graph for the enabled analyses. */
+    DependencyGraph dependencyGraph() const;
+
+    /** Run all enabled analyses.
+     *
+     *  Runs the enabled analyses for all functions using up to @p nThreads threads (zero means use the hardware
+     *  concurrency). Returns when all work is complete. Timing information from any previous run is discarded. */
+    void run(size_t nThreads);
+
+    /** Timeline from the most recent run, indexed by task ID. */
+    const std::vector<TaskTiming>& timeline() const { return timeline_; }
+
+    /** Wall time of the most recent run in seconds. */
+    double elapsed() const { return elapsed_; }
+
+    /** Sum of the durations of all tasks of the most recent run.
+     *
+     *  Dividing this by @ref elapsed gives the average parallelism that was achieved. */
+    double totalWork() const;
+
+    /** Critical path of the most recent run.
+     *
+     *  Returns the task IDs of the longest chain of dependent tasks as measured by task durations, listed from the first task
+     *  to run to the last. No amount of additional parallelism can make the run finish faster than the sum of these task
+     *  durations. */
+    std::vector<size_t> criticalPath() const;
+
+    /** Sum of the durations of the tasks on the critical path. */
+    double criticalPathTime() const;
+
+    /** Print a summary of the most recent run.
+     *
+     *  The summary includes the elapsed time, the total work, and the tasks along the critical path. */
+    void printTimeline(std::ostream&) const;
+
+    /** Name of an analysis. */
+    static std::string analysisName(Analysis);
+
+private:
+    void nameNoopFunctions() const;
+    void assignCallingConventionDefinitions(const std::vector<CallingConvention::Dictionary>&) const;
+};
+
+} // namespace
+} // namespace
+} // namespace
+
+#endif
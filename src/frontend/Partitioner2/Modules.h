@@ -8,6 +8,7 @@
 #include <Partitioner2/Thunk.h>
 #include <Partitioner2/Utility.h>
 
+#include <Sawyer/Callbacks.h>
 #include <Sawyer/SharedPointer.h>
 
 namespace Rose {
@@ -474,6 +475,68 @@ SgAsmBlock* buildGlobalBlockAst(const Partitioner&, const AstConstructionSetting
 SgAsmBlock* buildAst(const Partitioner&, SgAsmInterpretation *interp=NULL,
                      const AstConstructionSettings &settings = AstConstructionSettings::strict());
 
+/** Callback for building function ASTs one at a time.
+ *
+ *  See @ref buildFunctionAsts. */
+class FunctionAstCallback: public Sawyer::SharedObject {
+public:
+    /** Shared-ownership pointer to a @ref FunctionAstCallback. See @ref heap_object_shared_ownership. */
+    typedef Sawyer::SharedPointer<FunctionAstCallback> Ptr;
+
+    /** Results coordinated across all callbacks. */
+    struct Results {
+        bool keep;                                      /**< Caller takes ownership of the AST instead of it being deleted. */
+        bool stop;                                      /**< Do not build ASTs for any more functions. */
+        Results(): keep(false), stop(false) {}
+    };
+
+    /** Arguments passed to the callback. */
+    struct Args {
+        const Partitioner &partitioner;                 /**< Partitioner from which the AST was built. */
+        Function::Ptr function;                         /**< Function whose AST was built. */
+        SgAsmFunction *ast;                             /**< AST for the function. */
+        Results &results;                               /**< Results to control what happens to the AST. */
+        Args(const Partitioner &partitioner, const Function::Ptr &function, SgAsmFunction *ast, Results &results)
+            : partitioner(partitioner), function(function), ast(ast), results(results) {}
+    };
+
+    /** Callback method.
+     *
+     *  This is the method invoked for the callback.  The @p chain argument is the return value from the previous callback in
+     *  the list (true for the first callback).  The successor callbacks use @p chain to indicate whether subsequent callbacks
+     *  should do anything. */
+    virtual bool operator()(bool chain, const Args&) = 0;
+};
+
+/** List of callbacks for building function ASTs one at a time. */
+typedef Sawyer::Callbacks<FunctionAstCallback::Ptr> FunctionAstCallbacks;
+
+/** Build function ASTs one at a time.
+ *
+ *  This is an alternative to @ref buildAst for tools that operate on one function at a time. Instead of building the AST for
+ *  the entire specimen before returning, it builds the AST for each function in turn (in order of entry address), invokes
+ *  the callbacks, and then deletes that function's AST unless a callback asked to keep it. At most one function AST exists at a
+ *  time (plus those that were kept).
+ *
+ *  Pointers in each function AST are fixed up as if by @ref fixupAstPointers. Since the other functions are not present in
+ *  the AST, references to other functions and their blocks and instructions remain absolute addresses.
+ *
+ *  If the settings' @c copyAllInstructions is false (as it is for @ref AstConstructionSettings::streaming) then the AST's
+ *  basic blocks point to the partitioner's instruction nodes instead of copies, and those instructions' parent pointers point
+ *  into the function AST until it is deleted. A callback that keeps an AST in this mode must be aware that the instructions
+ *  are still owned by the partitioner.
+ *
+ *  Returns the number of functions whose ASTs were built. */
+size_t buildFunctionAsts(const Partitioner&, const FunctionAstCallbacks&, SgAsmInterpretation *interp=NULL,
+                         const AstConstructionSettings &settings = AstConstructionSettings::streaming());
+
+/** Delete a function AST.
+ *
+ *  Deletes an AST that was built by @ref buildFunctionAst or @ref buildFunctionAsts with the same settings. If the settings
+ *  indicate that instructions were not copied then the instructions are detached from the AST and not deleted since they
+ *  belong to the partitioner. The function AST must not be attached to a parent. */
+void deleteFunctionAst(SgAsmFunction*, const AstConstructionSettings&);
+
 /** Fixes pointers in the AST.
  *
  *  Traverses the AST to find SgAsmIntegerValueExpressions and changes absolute values to relative values.  If such an
@@ -3,6 +3,9 @@
 
 #include <Partitioner2/Modules.h>
 #include <Partitioner2/Thunk.h>
+#include <Sawyer/Map.h>
+#include <Sawyer/SharedPointer.h>
+#include <set>
 
 namespace Rose {
 namespace BinaryAnalysis {
@@ -88,6 +91,16 @@ public:
     virtual bool operator()(bool chain, const Args&) ROSE_OVERRIDE;
 };
 
+/** Jump table for a "switch" statement. */
+struct SwitchTable {
+    AddressInterval table;                              /**< Location of the table of case addresses. */
+    size_t entrySize;                                   /**< Size of each table entry in bytes. */
+    std::set<rose_addr_t> targets;                      /**< Distinct case addresses read from the table. */
+
+    SwitchTable()
+        : entrySize(0) {}
+};
+
 /** Basic block callback to detect "switch" statements.
  *
  *  Examines the instructions of a basic block to determine if they are from a C "switch"-like statement and attempts to find
@@ -96,6 +109,73 @@ class SwitchSuccessors: public BasicBlockCallback {
 public:
     static Ptr instance() { return Ptr(new SwitchSuccessors); } /**< Allocating constructor. */
     virtual bool operator()(bool chain, const Args&) ROSE_OVERRIDE;
+
+    /** Find the jump table for a basic block.
+     *
+     *  Returns the table if the block ends with an indirect jump through a table of case addresses, or nothing otherwise. The
+     *  partitioner and basic block are not modified, so this can be called concurrently for different blocks. */
+    static Sawyer::Optional<SwitchTable> analyze(const Partitioner&, const BasicBlock::Ptr&);
+
+    /** Replace a basic block's successors with the cases of a jump table.
+     *
+     *  The basic block must not be attached to the partitioner. A data block for the table is also attached to the basic
+     *  block. */
+    static void apply(const BasicBlock::Ptr&, const SwitchTable&);
+};
+
+/** Resolves "switch" statements after basic blocks are discovered.
+ *
+ *  The @ref SwitchSuccessors callback examines each basic block when it's created, and a block may be created many times
+ *  during partitioning since blocks are detached and rediscovered as the CFG changes. This class is an alternative that
+ *  examines blocks in batches: each call to @ref resolve finds all attached blocks that end with an indirect JMP whose
+ *  successor is still indeterminate, looks for their jump tables in parallel, and then updates the CFG for all the tables
+ *  that were found.
+ *
+ *  Results are cached by block address, instruction bytes, and the address of the function that follows the block (which
+ *  limits where the case labels can be), so a block that is unchanged since it was last examined is not examined again, even
+ *  if it was detached and rediscovered in the meantime. A block is examined again if a function is created between it and
+ *  the next function. */
+class DeferredSwitchResolver: public Sawyer::SharedObject {
+public:
+    /** Shared-ownership pointer. */
+    typedef Sawyer::SharedPointer<DeferredSwitchResolver> Ptr;
+
+private:
+    typedef Sawyer::Container::Map<std::string, Sawyer::Optional<SwitchTable> > Cache;
+    Cache cache_;                                       // results indexed by block address, next function, and insn bytes
+    size_t nAnalyzed_;                                  // number of blocks analyzed
+    size_t nCacheHits_;                                 // number of blocks whose results were already cached
+    size_t nResolved_;                                  // number of blocks whose successors were changed
+
+protected:
+    DeferredSwitchResolver()
+        : nAnalyzed_(0), nCacheHits_(0), nResolved_(0) {}
+
+public:
+    /** Allocating constructor. */
+    static Ptr instance() { return Ptr(new DeferredSwitchResolver); }
+
+    /** Resolve switch statements.
+     *
+     *  Analyzes all unresolved blocks using up to @p nThreads threads (zero means use the hardware concurrency) and then
+     *  updates the CFG. Returns the number of blocks whose successors were changed, in which case the caller should discover
+     *  the new basic blocks and then call this again. */
+    size_t resolve(Partitioner&, size_t nThreads);
+
+    /** Number of blocks analyzed. */
+    size_t nAnalyzed() const { return nAnalyzed_; }
+
+    /** Number of blocks whose results came from the cache. */
+    size_t nCacheHits() const { return nCacheHits_; }
+
+    /** Number of blocks whose successors were replaced by switch cases. */
+    size_t nResolved() const { return nResolved_; }
+
+    /** Cache key for a basic block.
+     *
+     *  The @p nextFunctionVa is the entry address of the first function at or after the block's fall-through address, if
+     *  any. This is the only state of the partitioner besides the memory map that affects @ref SwitchSuccessors::analyze. */
+    static std::string cacheKey(const BasicBlock::Ptr&, const Sawyer::Optional<rose_addr_t> &nextFunctionVa);
 };
 
 /** Matches "ENTER x, 0" */
@@ -7,5 +7,11 @@
  *  in the AST that is frontend-specific.   All violations are fixed in place.  Returns the number of violations found/fixed. */
 size_t checkIsFrontendSpecificFlag(SgNode *ast);
 
+/** Same as checkIsFrontendSpecificFlag followed by checkIsCompilerGeneratedFlag, but in a single traversal.
+ *
+ *  Each node is marked as frontend-specific before it is checked for being compiler-generated, so the result is the same as
+ *  calling the two functions in that order.  Returns the total number of violations found/fixed by both checks. */
+size_t checkIsFrontendSpecificAndCompilerGeneratedFlags(SgNode *ast);
+
 
 #endif
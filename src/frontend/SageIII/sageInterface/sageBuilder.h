@@ -225,6 +225,18 @@ ROSE_DLL_API SgTypeUnknown * buildUnknownType();
 //! statements that change the rules.
 ROSE_DLL_API SgType* buildFortranImplicitType(SgName name);
 
+//! Clear the table used by the type builders to find previously built types without building mangled names.
+/*! buildPointerType(), buildReferenceType(), buildRvalueReferenceType(), buildConstType(), buildVolatileType(),
+    buildConstVolatileType(), buildRestrictType(), buildFunctionType() and buildMemberFunctionType() record the
+    types they return, keyed by the kind of type, the base (or return) type, the modifiers, the class type and
+    the argument types (modifier types with any type modifier state other than const, volatile and restrict are
+    not recorded). Types that were deleted or modified since are not returned. The table is cleared automatically
+    when the global type tables are replaced, when AST_FILE_IO rebuilds the memory pools, by
+    SageInterface::deleteAST() and by the AST merge; code that deletes types otherwise, or rebuilds the global type
+    tables in place, should call this function.
+ */
+ROSE_DLL_API void clearTypeHashConsTable();
+
 //! Build a pointer type
 ROSE_DLL_API SgPointerType* buildPointerType(SgType *base_type = NULL);
 
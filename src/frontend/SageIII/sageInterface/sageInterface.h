@@ -632,6 +632,133 @@ SgStatement* lastStatementOfScopeWithTokenInfo (SgScopeStatement* scope, std::ma
 
 //@}
 
+//------------------------------------------------------------------------
+//@{
+/*! @name Frozen (read-only) AST
+  \brief Support for running independent read-only analyses concurrently over one AST.
+
+  Many queries that look read-only update lazily built state: get_mangled_name() fills the global
+  mangled name caches and the symbol table lookup functions record the last name and position searched.
+  freezeAst() finalizes the mangled name caches for every declaration, initialized name, type and scope in
+  the memory pools, after which the following queries can be called from multiple threads until thawAst():
+    - getMangledNameFromCache() and addMangledNameToCache(), the caches behind get_mangled_name() (names
+      found in the caches are read without locking, names of other nodes are returned without being cached,
+      and the short mangled name cache is locked),
+    - lookupSymbolInParentScopes() and the other lookup*SymbolInParentScopes() functions (each call,
+      including the traversal of the scopes, is serialized with one recursive lock),
+    - mangleType() (its type string cache is only read),
+    - the AST traversals and NodeQuery::querySubTree(), which only read the AST.
+
+  The member functions of SgScopeStatement (lookup_*_symbol() and the others that search the symbol table) and of
+  SgSymbolTable (find*() and the others) are not guarded and must not be called concurrently, even when the AST
+  is frozen; threads must use the SageInterface lookup*SymbolInParentScopes() functions instead.
+
+  freezeAst() and thawAst() must not be called while other threads are using the AST, and the AST must not be
+  modified while it is frozen. In debug builds (NDEBUG not defined) the SageInterface statement insertion,
+  removal, replacement and deletion functions abort when the AST is frozen, and thawAst() aborts if the
+  number of IR nodes in the memory pools changed while the AST was frozen.
+*/
+
+//! Finalize the lazily built caches and enter the frozen (read-only) AST mode.
+ROSE_DLL_API void freezeAst (SgProject* project);
+
+//! Leave the frozen AST mode (the AST can be modified again).
+ROSE_DLL_API void thawAst ();
+
+//! Is the AST in frozen (read-only) mode?
+ROSE_DLL_API bool isAstFrozen ();
+
+//! In debug builds, abort with a message naming the caller if the AST is frozen (used by functions that modify the AST).
+ROSE_DLL_API void checkAstIsNotFrozen (const char* functionName);
+
+//@}
+
+//------------------------------------------------------------------------
+//@{
+/*! @name Source position index
+  \brief Lookup of the located nodes at a source position without traversing the AST.
+
+  A SourcePositionIndex is built in one traversal of an AST and maps the source range of each SgLocatedNode
+  (from its startOfConstruct to its endOfConstruct, using the logical file, line and column) to the node, with
+  a separate interval index for each file.  Nodes without a source position in a file (transformations,
+  nodes whose start and end are in different files) are not indexed.  A column of zero or less means the start
+  of the line in a position or the start of a range, and the end of the line in the end of a range (so
+  findOverlapping(filename,line,0,line,0) finds the nodes on a line).
+
+  Every SourcePositionIndex that exists is kept up to date by exactly these SageInterface functions:
+  appendStatement(), prependStatement(), insertStatement(), replaceStatement(), removeStatement(),
+  replaceExpression(), deepDelete() and deleteAST() (and the functions that are implemented with them, such as
+  insertStatementBefore()).  Code that modifies the AST by any other means must call addToSourcePositionIndexes()
+  and removeFromSourcePositionIndexes().  Queries only read the index and can be called concurrently, updates can not.
+
+  Example:
+  \code
+    SageInterface::SourcePositionIndex index(project);
+    SgLocatedNode* node = index.findInnermost("/home/user/example.C",42,7);
+  \endcode
+*/
+class ROSE_DLL_API SourcePositionIndex
+   {
+     public:
+       //! Build an empty index (see build())
+          SourcePositionIndex();
+
+       //! Build the index of the located nodes in the AST rooted at root
+          explicit SourcePositionIndex(SgNode* root);
+
+         ~SourcePositionIndex();
+
+       //! Discard the index and index the located nodes in the AST rooted at root
+          void build(SgNode* root);
+
+       //! Discard the index
+          void clear();
+
+       //! Root of the indexed AST (NULL if the index has not been built)
+          SgNode* get_root() const;
+
+       //! Number of indexed nodes
+          size_t size() const;
+
+       //! Index the located nodes of a subtree that was added to the indexed AST
+          void insert(SgNode* subtree);
+
+       //! Remove the located nodes of a subtree from the index (before it is removed from the AST or deleted)
+          void erase(SgNode* subtree);
+
+       //! The innermost node whose source range contains the position (NULL if there is none)
+       /*! The node with the smallest source range is returned, and of nodes with the same source range the
+           deepest in the AST (e.g. the SgExprStatement rather than the SgBasicBlock of a block holding one statement).
+        */
+          SgLocatedNode* findInnermost(const std::string & filename, int line, int column) const;
+          SgLocatedNode* findInnermost(int file_id, int line, int column) const;
+
+       //! All nodes whose source range contains the position, outermost first
+          std::vector<SgLocatedNode*> findEnclosing(const std::string & filename, int line, int column) const;
+          std::vector<SgLocatedNode*> findEnclosing(int file_id, int line, int column) const;
+
+       //! All nodes whose source range overlaps the range from (startLine,startColumn) to (endLine,endColumn), ordered by start position
+          std::vector<SgLocatedNode*> findOverlapping(const std::string & filename, int startLine, int startColumn, int endLine, int endColumn) const;
+          std::vector<SgLocatedNode*> findOverlapping(int file_id, int startLine, int startColumn, int endLine, int endColumn) const;
+
+     private:
+          class Implementation;
+
+       // Not copyable (each index registers itself to be updated by the SageInterface transformations).
+          SourcePositionIndex(const SourcePositionIndex &);
+          SourcePositionIndex & operator=(const SourcePositionIndex &);
+
+          Implementation* implementation;
+   };
+
+//! Index the located nodes of a subtree that was added to the AST in every SourcePositionIndex that includes it
+ROSE_DLL_API void addToSourcePositionIndexes (SgNode* subtree);
+
+//! Remove the located nodes of a subtree from every SourcePositionIndex (call before the subtree is removed or deleted)
+ROSE_DLL_API void removeFromSourcePositionIndexes (SgNode* subtree);
+
+//@}
+
 //------------------------------------------------------------------------
 //@{
 /*! @name AST properties
@@ -1964,6 +1964,7 @@ Process (SgProject* project, std::vector<std::string>& argv)
       std::cout << "[INFO] Processing Fortran's OFP frontend commandline options" << std::endl;
 
   ProcessJvmOptions(project, argv);
+  ProcessJvmFastStartup(project, argv);
   ProcessEnableRemoteDebugging(project, argv);
 }
 
@@ -2007,6 +2008,29 @@ ProcessJvmOptions (SgProject* project, std::vector<std::string>& argv)
   }// has_ofp_jvm_options
 }// Cmdline::Fortran::ProcessJvmOptions
 
+void
+Rose::Cmdline::Fortran::Ofp::
+ProcessJvmFastStartup (SgProject* project, std::vector<std::string>& argv)
+{
+  bool has_ofp_jvm_fast_startup =
+      // -rose:fortran:ofp:jvm_fast_startup
+      CommandlineProcessing::isOption(
+          argv,
+          Fortran::option_prefix,
+          "ofp:jvm_fast_startup",
+          Cmdline::REMOVE_OPTION_FROM_ARGV);
+
+  if (has_ofp_jvm_fast_startup)
+  {
+      if (SgProject::get_verbose() > 1)
+          std::cout << "[INFO] Processing ofp JVM fast startup option" << std::endl;
+
+      // Placed before any -rose:fortran:ofp:jvm_options so those still win.
+      Cmdline::Fortran::Ofp::jvm_options.push_front("-Xshare:auto");
+      Cmdline::Fortran::Ofp::jvm_options.push_front("-XX:TieredStopAtLevel=1");
+  }// has_ofp_jvm_fast_startup
+}// Cmdline::Fortran::Ofp::ProcessJvmFastStartup
+
 void
 Rose::Cmdline::Fortran::Ofp::
 ProcessEnableRemoteDebugging (SgProject* project, std::vector<std::string>& argv)
@@ -2899,6 +2923,7 @@ Process (SgProject* project, std::vector<std::string>& argv)
 
   ProcessBatchMode(project, argv);
   ProcessJvmOptions(project, argv);
+  ProcessJvmFastStartup(project, argv);
   ProcessEnableRemoteDebugging(project, argv);
 }
 
@@ -2942,6 +2967,29 @@ ProcessJvmOptions (SgProject* project, std::vector<std::string>& argv)
   }// has_ecj_jvm_options
 }// Cmdline::Java::ProcessJvmOptions
 
+void
+Rose::Cmdline::Java::Ecj::
+ProcessJvmFastStartup (SgProject* project, std::vector<std::string>& argv)
+{
+  bool has_ecj_jvm_fast_startup =
+      // -rose:java:ecj:jvm_fast_startup
+      CommandlineProcessing::isOption(
+          argv,
+          Java::option_prefix,
+          "ecj:jvm_fast_startup",
+          Cmdline::REMOVE_OPTION_FROM_ARGV);
+
+  if (has_ecj_jvm_fast_startup)
+  {
+      if (SgProject::get_verbose() > 1)
+          std::cout << "[INFO] Processing ECJ JVM fast startup option" << std::endl;
+
+      // Placed before any -rose:java:ecj:jvm_options so those still win.
+      Cmdline::Java::Ecj::jvm_options.push_front("-Xshare:auto");
+      Cmdline::Java::Ecj::jvm_options.push_front("-XX:TieredStopAtLevel=1");
+  }// has_ecj_jvm_fast_startup
+}// Cmdline::Java::Ecj::ProcessJvmFastStartup
+
 void
 Rose::Cmdline::Java::Ecj::
 ProcessEnableRemoteDebugging (SgProject* project, std::vector<std::string>& argv)
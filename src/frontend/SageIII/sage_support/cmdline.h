@@ -124,6 +124,13 @@ namespace Cmdline {
       ROSE_DLL_API void
       ProcessJvmOptions (SgProject* project, std::vector<std::string>& argv);
 
+      /** -rose:fortran:ofp:jvm_fast_startup
+       *  Start the JVM with -XX:TieredStopAtLevel=1 and -Xshare:auto, which
+       *  may shorten startup when only a few small files are parsed.
+       */
+      ROSE_DLL_API void
+      ProcessJvmFastStartup (SgProject* project, std::vector<std::string>& argv);
+
       /** -rose:fortran:ofp:enable_remote_debugging
        *  Enable remote debugging of the Java Virtual Machine (JVM).
        */
@@ -357,6 +364,13 @@ namespace Cmdline {
       ROSE_DLL_API void
       ProcessJvmOptions (SgProject* project, std::vector<std::string>& argv);
 
+      /** -rose:java:ecj:jvm_fast_startup
+       *  Start the JVM with -XX:TieredStopAtLevel=1 and -Xshare:auto, which
+       *  may shorten startup when only a few small files are parsed.
+       */
+      ROSE_DLL_API void
+      ProcessJvmFastStartup (SgProject* project, std::vector<std::string>& argv);
+
       /** -rose:java:ecj:enable_remote_debugging
        *  Enable remote debugging of the Java Virtual Machine (JVM).
        */
@@ -2,6 +2,7 @@
 #define ROSE_BinaryAnalysis_FeasiblePath_H
 
 #include <BaseSemantics2.h>
+#include <BinaryFunctionSummaryDatabase.h>
 #include <BinarySmtSolver.h>
 #include <BinarySymbolicExprParser.h>
 #include <Partitioner2/CfgPath.h>
@@ -199,6 +200,7 @@ public:
         rose_addr_t address;                            /**< Address of summarized function. */
         int64_t stackDelta;                             /**< Stack delta for summarized function. */
         std::string name;                               /**< Name of summarized function. */
+        std::vector<std::string> outputRegisters;       /**< Registers written by the function, if known. */
 
         /** Construct empty function summary. */
         FunctionSummary(): stackDelta(SgAsmInstruction::INVALID_STACK_DELTA) {}
@@ -257,6 +259,8 @@ private:
     Partitioner2::CfgConstEdgeSet cfgAvoidEdges_;       // CFG edges to avoid
     Partitioner2::CfgConstVertexSet cfgEndAvoidVertices_;// CFG end-of-path and other avoidance vertices
     FunctionSummarizer::Ptr functionSummarizer_;        // user-defined function for handling function summaries
+    FunctionSummaryDatabase::Ptr summaryDatabase_;      // optional precomputed summaries indexed by function content
+    FunctionSummaryDatabase::FunctionHashes summaryHashes_;// database keys for the partitioner's functions, computed lazily
     AddressSet reachedBlockVas_;                        // basic block addresses reached during analysis
     static Sawyer::Attribute::Id POST_STATE;            // stores semantic state after executing the insns for a vertex
     static Sawyer::Attribute::Id POST_INSN_LENGTH;      // path length in instructions at end of vertex
@@ -286,6 +290,7 @@ public:
         cfgAvoidEdges_.clear();
         cfgEndAvoidVertices_.clear();
         reachedBlockVas_.clear();
+        summaryHashes_.clear();
     }
 
     /** Initialize diagnostic output. This is called automatically when ROSE is initialized. */
@@ -390,6 +395,18 @@ public:
     void functionSummarizer(const FunctionSummarizer::Ptr &f) { functionSummarizer_ = f; }
     /** @} */
 
+    /** Property: Function summary database.
+     *
+     *  If non-null, then when a function call is summarized the callee is looked up in this database by its content hash. A
+     *  stored stack delta is used when the callee's own stack delta is unknown, and the registers the callee is known to write
+     *  are given unknown values after the call. See @ref FunctionSummaryDatabase. The database keys of the partitioner's
+     *  functions are computed the first time a call is summarized after @ref setSearchBoundary.
+     *
+     *  @{ */
+    FunctionSummaryDatabase::Ptr summaryDatabase() const { return summaryDatabase_; }
+    void summaryDatabase(const FunctionSummaryDatabase::Ptr &db) { summaryDatabase_ = db; summaryHashes_.clear(); }
+    /** @} */
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Utilities
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
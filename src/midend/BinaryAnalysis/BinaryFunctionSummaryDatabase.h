@@ -0,0 +1,204 @@
+#ifndef ROSE_BinaryAnalysis_FunctionSummaryDatabase_H
+#define ROSE_BinaryAnalysis_FunctionSummaryDatabase_H
+
+#include <Partitioner2/BasicTypes.h>
+#include <Partitioner2/Function.h>
+#include <BinaryCallingConvention.h>
+#include <RoseException.h>
+#include <Sawyer/Map.h>
+#include <Sawyer/Message.h>
+#include <Sawyer/SharedPointer.h>
+#include <boost/filesystem.hpp>
+#include <boost/thread/mutex.hpp>
+#include <string>
+#include <vector>
+
+namespace Rose {
+namespace BinaryAnalysis {
+
+/** Persistent database of function summaries.
+ *
+ *  Analyses such as @ref FeasiblePath summarize a function call instead of inlining the callee. Computing a summary requires
+ *  stack delta and calling convention analysis of the callee, which in turn requires the same for all of its callees. Library
+ *  functions such as those in the C library are therefore summarized over and over, once for every specimen and every run of a
+ *  tool.
+ *
+ *  This database stores summaries indexed by a hash of the function's content rather than by its address, so a summary computed
+ *  for one specimen can be reused for any other specimen that contains the same function, even at a different address. A
+ *  function's summary depends on what its callees do, so the hash covers the function's instruction bytes and the hashes of
+ *  all functions it calls (see @ref functionHashes). The database can be saved to a file and loaded again later.
+ *
+ *  A summary records the function's stack delta, the registers it reads and writes, and the stack locations it reads and
+ *  writes. These are the inputs and outputs computed by calling convention analysis, and are what an analysis needs in order to
+ *  step over a call: the outputs are the locations whose values are unknown after the call.
+ *
+ *  Summaries are computed bottom-up over the call graph (callees before callers) using multiple threads. Functions whose
+ *  summaries are already in the database are not analyzed again; instead, their stack delta is copied into the function's @ref
+ *  Partitioner2::Function::stackDeltaOverride "stack delta override" so that the analyses of their callers can use it.
+ *
+ *  Finding and inserting summaries are thread safe. */
+class FunctionSummaryDatabase: public Sawyer::SharedObject {
+public:
+    /** Reference counting pointer. */
+    typedef Sawyer::SharedPointer<FunctionSummaryDatabase> Ptr;
+
+    /** Function hashes indexed by function entry address. */
+    typedef Sawyer::Container::Map<rose_addr_t, std::string> FunctionHashes;
+
+    /** Location on the stack. */
+    struct StackLocation {
+        int64_t offset;                                 /**< Offset from the stack pointer at the function entry. */
+        size_t nBytes;                                  /**< Size of the location in bytes. */
+
+        StackLocation()
+            : offset(0), nBytes(0) {}
+        StackLocation(int64_t offset, size_t nBytes)
+            : offset(offset), nBytes(nBytes) {}
+    };
+
+    /** Summary for one function. */
+    struct Record {
+        std::string hash;                               /**< Hash of the function content. This is the database key. */
+        std::string name;                               /**< Name of the function where the summary was first computed. */
+        int64_t stackDelta;                             /**< Stack delta, or @c SgAsmInstruction::INVALID_STACK_DELTA. */
+        bool converged;                                 /**< Whether the calling convention analysis converged. */
+        std::vector<std::string> inputRegisters;        /**< Registers read before being written. */
+        std::vector<std::string> outputRegisters;       /**< Registers written by the function. */
+        std::vector<StackLocation> inputStack;          /**< Stack locations read before being written. */
+        std::vector<StackLocation> outputStack;         /**< Stack locations written by the function. */
+        std::vector<std::string> calleeHashes;          /**< Hashes of the functions called by this function. */
+
+        Record()
+            : stackDelta(SgAsmInstruction::INVALID_STACK_DELTA), converged(false) {}
+
+        /** Print a one-line description. */
+        void print(std::ostream&) const;
+    };
+
+    /** Statistics about database use. */
+    struct Stats {
+        size_t nHits;                                   /**< Number of functions whose summary was found in the database. */
+        size_t nMisses;                                 /**< Number of functions that had to be analyzed. */
+
+        Stats()
+            : nHits(0), nMisses(0) {}
+    };
+
+    /** Diagnostic output. */
+    static Sawyer::Message::Facility mlog;
+
+private:
+    typedef Sawyer::Container::Map<std::string /*hash*/, Record> Records;
+
+    mutable boost::mutex mutex_;                        // protects all of the following data members
+    Records records_;
+    Stats stats_;
+
+protected:
+    FunctionSummaryDatabase() {}
+
+public:
+    /** Allocating constructor. Returns an empty database. */
+    static Ptr instance() {
+        return Ptr(new FunctionSummaryDatabase);
+    }
+
+    /** Initialize diagnostic output. This is called automatically when ROSE is initialized. */
+    static void initDiagnostics();
+
+    /** Hash of a function's instructions.
+     *
+     *  The hash is computed from the bytes of the function's instructions in order of their addresses. Neither the function's
+     *  address nor its callees are part of the hash. */
+    static std::string contentHash(const Partitioner2::Partitioner&, const Partitioner2::Function::Ptr&);
+
+    /** Database keys for all functions.
+     *
+     *  A function's key is the hash of its @ref contentHash "instructions" together with the keys of the functions it calls,
+     *  so a function has the same key in two specimens only if it and everything it calls (directly or indirectly) are the
+     *  same.  Mutually recursive functions are hashed as a group: the group's hash covers the instructions of all the members
+     *  and the keys of the functions called from the group, and each member's key is its instruction hash combined with its
+     *  group's hash.  The keys therefore don't depend on the order in which the call graph is traversed. */
+    static FunctionHashes functionHashes(const Partitioner2::Partitioner&);
+
+    /** Database key for one function.
+     *
+     *  This is the function's entry in @ref functionHashes, or an empty string if the function is not attached to the
+     *  partitioner. Since computing it requires hashing all the functions, call @ref functionHashes instead when more than one
+     *  key is needed. */
+    static std::string functionHash(const Partitioner2::Partitioner&, const Partitioner2::Function::Ptr&);
+
+    /** Number of summaries in the database. */
+    size_t size() const;
+
+    /** Find a summary.
+     *
+     *  Returns the summary for the specified hash, or nothing if there is no such summary. */
+    Sawyer::Optional<Record> find(const std::string &hash) const;
+
+    /** Find the summary for a function.
+     *
+     *  Looks up the function's key from @p hashes (as returned by @ref functionHashes) and returns the corresponding summary,
+     *  or nothing if the function has no key or there is no summary. */
+    Sawyer::Optional<Record> find(const FunctionHashes &hashes, const Partitioner2::Function::Ptr&) const;
+
+    /** Insert a summary.
+     *
+     *  Inserts the summary, replacing any summary that already exists for the same hash. */
+    void insert(const Record&);
+
+    /** Remove all summaries. */
+    void clear();
+
+    /** Statistics.
+     *
+     *  Returns the number of functions that were found in the database or analyzed by @ref computeSummaries since the database
+     *  was created or the statistics were last reset.
+     *
+     * @{ */
+    Stats stats() const;
+    void resetStats();
+    /** @} */
+
+    /** Compute summaries for all functions.
+     *
+     *  Analyzes the partitioner's functions in parallel using up to @p nThreads threads (zero means use the hardware
+     *  concurrency), callees before callers. Functions already in the database are not analyzed; their stored stack deltas are
+     *  copied into the function objects instead. New summaries are inserted into the database. */
+    void computeSummaries(const Partitioner2::Partitioner&, size_t nThreads,
+                          const CallingConvention::Definition::Ptr &dfltCc = CallingConvention::Definition::Ptr());
+
+    /** Compute the summary for one function.
+     *
+     *  Runs stack delta and calling convention analysis for the function (using cached results if they are present) and
+     *  returns the summary without inserting it into the database. */
+    static Record summarize(const Partitioner2::Partitioner&, const Partitioner2::Function::Ptr&,
+                            const CallingConvention::Definition::Ptr &dfltCc = CallingConvention::Definition::Ptr());
+
+    /** Load summaries from a file.
+     *
+     *  Summaries from the file are added to those already in the database. Throws an @ref Exception if the file cannot be read
+     *  or is not a summary database. */
+    void load(const boost::filesystem::path&);
+
+    /** Save summaries to a file.
+     *
+     *  Throws an @ref Exception if the file cannot be written. */
+    void save(const boost::filesystem::path&) const;
+
+    /** Exception thrown by the summary database. */
+    class Exception: public Rose::Exception {
+    public:
+        /** Construct exception with a message. */
+        explicit Exception(const std::string &mesg)
+            : Rose::Exception(mesg) {}
+        ~Exception() throw() {}
+    };
+};
+
+std::ostream& operator<<(std::ostream&, const FunctionSummaryDatabase::Record&);
+
+} // namespace
+} // namespace
+
+#endif
@@ -6,6 +6,7 @@
 #define __STDC_FORMAT_MACROS
 #endif
 #include <inttypes.h>
+#include <vector>
 
 #include "BaseSemantics2.h"
 #include "integerOps.h"
@@ -26,6 +27,87 @@ typedef Sawyer::Container::Interval<uint64_t> Interval;
 /** Set of intervals. */
 typedef Sawyer::Container::IntervalSet<Interval> Intervals;
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Merging interval values
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Shared-ownership pointer for a merge control object. See @ref heap_object_shared_ownership. */
+typedef Sawyer::SharedPointer<class Merger> MergerPtr;
+
+/** Controls merging of interval values.
+ *
+ *  The interval lattice has infinite ascending chains (well, 2^64 of them), so a data-flow analysis over a loop whose body
+ *  increments a counter would otherwise visit every possible counter value before reaching a fixed point. When a merger of
+ *  this type is attached to the register and memory states, merging two values applies a widening operator once a value has
+ *  been changed by merging more than @ref wideningDelay times: any bound that grew is moved outward to the next widening
+ *  threshold, or to the extreme of the value's domain if there is no such threshold.  Since the set of thresholds is finite,
+ *  every ascending chain is finite and @ref DataFlow::Engine reaches a fixed point.  Precision lost by widening can be
+ *  partially recovered afterward with @ref SValue::createNarrowed. */
+class Merger: public BaseSemantics::Merger {
+    bool widening_;
+    size_t wideningDelay_;
+    std::vector<uint64_t> thresholds_;                  // sorted and unique
+
+protected:
+    Merger(): BaseSemantics::Merger(), widening_(true), wideningDelay_(3) {}
+
+public:
+    /** Shared-ownership pointer for a @ref Merger object. See @ref heap_object_shared_ownership. */
+    typedef MergerPtr Ptr;
+
+    /** Allocating constructor. */
+    static Ptr instance() {
+        return Ptr(new Merger);
+    }
+
+    /** Allocating constructor with a widening delay. */
+    static Ptr instance(size_t wideningDelay) {
+        Ptr retval = Ptr(new Merger);
+        retval->wideningDelay(wideningDelay);
+        return retval;
+    }
+
+    /** Property: Whether merging applies the widening operator.
+     *
+     *  If false, merging is the plain set union of the two values' intervals (subject to the usual complexity limit).
+     *
+     * @{ */
+    bool widening() const { return widening_; }
+    void widening(bool b) { widening_ = b; }
+    /** @} */
+
+    /** Property: Number of merges before widening.
+     *
+     *  A value is widened only after it has been changed by this many merges.  A small delay lets short loops be analyzed
+     *  exactly while still guaranteeing termination.
+     *
+     * @{ */
+    size_t wideningDelay() const { return wideningDelay_; }
+    void wideningDelay(size_t n) { wideningDelay_ = n; }
+    /** @} */
+
+    /** Property: Widening thresholds.
+     *
+     *  When a bound is widened it moves to the nearest threshold that still contains the merged value rather than directly to
+     *  the extreme of the domain.  Good thresholds are the constants that appear in comparisons, such as the number of entries
+     *  in a jump table or the size of a stack buffer.
+     *
+     * @{ */
+    const std::vector<uint64_t>& thresholds() const { return thresholds_; }
+    void thresholds(const std::vector<uint64_t> &v);
+    /** @} */
+
+    /** Insert one widening threshold. */
+    void insertThreshold(uint64_t v);
+
+    /** Smallest threshold that is greater than or equal to @p v and not greater than @p mask, or @p mask. */
+    uint64_t thresholdAbove(uint64_t v, uint64_t mask) const;
+
+    /** Largest threshold that is less than or equal to @p v, or zero. */
+    uint64_t thresholdBelow(uint64_t v) const;
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                      Semantic values
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -38,27 +120,28 @@ class SValue: public BaseSemantics::SValue {
 protected:
     Intervals intervals_;
     bool isBottom_;
+    size_t nMerges_;                                    // number of merges that changed this value; see Merger
 
 protected:
     // Protected constructors. See base class and public members for documentation
     explicit SValue(size_t nbits):
-        BaseSemantics::SValue(nbits), isBottom_(false){
+        BaseSemantics::SValue(nbits), isBottom_(false), nMerges_(0) {
         intervals_.insert(Interval::hull(0, IntegerOps::genMask<uint64_t>(nbits)));
     }
     SValue(size_t nbits, uint64_t number)
-        : BaseSemantics::SValue(nbits), isBottom_(false) {
+        : BaseSemantics::SValue(nbits), isBottom_(false), nMerges_(0) {
         number &= IntegerOps::genMask<uint64_t>(nbits);
         intervals_.insert(number);
     }
     SValue(size_t nbits, uint64_t v1, uint64_t v2):
-        BaseSemantics::SValue(nbits), isBottom_(false) {
+        BaseSemantics::SValue(nbits), isBottom_(false), nMerges_(0) {
         v1 &= IntegerOps::genMask<uint64_t>(nbits);
         v2 &= IntegerOps::genMask<uint64_t>(nbits);
         ASSERT_require(v1<=v2);
         intervals_.insert(Interval::hull(v1, v2));
     }
     SValue(size_t nbits, const Intervals &intervals):
-        BaseSemantics::SValue(nbits), isBottom_(false) {
+        BaseSemantics::SValue(nbits), isBottom_(false), nMerges_(0) {
         ASSERT_require(!intervals.isEmpty());
         ASSERT_require((intervals.greatest() <= IntegerOps::genMask<uint64_t>(nbits)));
         intervals_ = intervals;
@@ -211,6 +294,26 @@ public:
     /** Returns all possible bits that could be set. */
     uint64_t possible_bits() const;
 
+    /** Number of merges that have changed this value.
+     *
+     *  This is the count that's compared with @ref Merger::wideningDelay. Values created by RISC operators start at zero and
+     *  each merge that produces a new value increments the count. */
+    size_t nMerges() const {
+        return nMerges_;
+    }
+
+    /** Narrow a widened value.
+     *
+     *  Returns a new value that is the narrowing of this value (typically the fixed point reached by widening) by @p other
+     *  (typically the value obtained by one more pass of the transfer functions over the fixed point).  Only a bound that
+     *  widening could have produced is narrowed: a lower bound of zero or equal to a threshold of @p merger is raised to the
+     *  least value of @p other if that is larger, and an upper bound at the domain's maximum or equal to a threshold is lowered
+     *  to the greatest value of @p other if that is smaller.  All other bounds are kept.  The result is this value's intervals
+     *  clipped to the new bounds, so it is never larger than this value, and it keeps this value's merge count.  If the
+     *  clipping leaves nothing (which happens only if @p other is not contained in this value) then a copy of @p other is
+     *  returned instead. */
+    SValuePtr createNarrowed(const SValuePtr &other, const MergerPtr &merger = MergerPtr()) const;
+
 };
 
 
@@ -0,0 +1,450 @@
+/*!
+ * An index for resolving abstract handles of ROSE AST nodes
+ */
+#include "sage3basic.h"
+#include <iostream>
+#include <algorithm>
+#include <limits>
+
+#include "abstract_handle.h"
+#include "roseAdapter.h"
+#include "handleIndex.h"
+
+using namespace std;
+
+namespace AbstractHandle
+{
+  // Collects the nodes of a subtree in pre-order, and for each node the position of the last node of its subtree
+  class PreorderCollector: public AstPrePostProcessing
+  {
+    public:
+      std::vector<SgNode*> nodes;
+      std::vector<size_t> lasts;
+    protected:
+      virtual void preOrderVisit(SgNode* n)
+      {
+        stack.push_back(nodes.size());
+        nodes.push_back(n);
+        lasts.push_back(0);
+      }
+      virtual void postOrderVisit(SgNode* n)
+      {
+        lasts[stack.back()] = nodes.size()-1;
+        stack.pop_back();
+      }
+    private:
+      std::vector<size_t> stack;
+  };
+
+  // keep a vector of (key, node) sorted by key
+  template <typename T>
+  static void insertSorted(std::vector<T>& v, const T& x)
+  {
+    if (v.empty() || v.back() < x)
+      v.push_back(x);
+    else
+      v.insert(std::lower_bound(v.begin(), v.end(), x), x);
+  }
+
+  template <typename T>
+  static void eraseSorted(std::vector<T>& v, const T& x)
+  {
+    typename std::vector<T>::iterator i = std::lower_bound(v.begin(), v.end(), x);
+    if (i != v.end() && *i == x)
+      v.erase(i);
+  }
+
+  // the start line used by roseNode::getStartPos(), 0 if there is none
+  static size_t getStartLine(SgNode* node)
+  {
+    SgLocatedNode* lnode = isSgLocatedNode(node);
+    if (lnode != NULL)
+      return lnode->get_file_info()->get_line();
+    return 0;
+  }
+
+  // the file name used by roseNode::getNumbering()
+  static string getNumberingFileName(SgNode* node)
+  {
+    Sg_File_Info* info = node->get_file_info();
+    if (info != NULL)
+      return info->get_filenameString();
+    return "";
+  }
+
+  HandleIndex::HandleIndex(): m_root(NULL)
+  {
+  }
+
+  HandleIndex::HandleIndex(SgNode* root): m_root(NULL)
+  {
+    build(root);
+  }
+
+  void HandleIndex::clear()
+  {
+    m_root = NULL;
+    m_nodes.clear();
+    m_positions.clear();
+    m_numberings.clear();
+    m_variant_files.clear();
+    m_names.clear();
+    m_named_variants.clear();
+    m_strings.clear();
+    m_handle_cache.clear();
+  }
+
+  // One traversal assigns keys to all nodes, spread evenly over the whole key space
+  void HandleIndex::build(SgNode* root)
+  {
+    clear();
+    m_root = root;
+    if (root == NULL)
+      return;
+    PreorderCollector collector;
+    collector.traverse(root);
+    bool ok = add(collector.nodes, collector.lasts, 0, std::numeric_limits<key_t>::max());
+    ROSE_ASSERT(ok);
+  }
+
+  bool HandleIndex::contains(SgNode* node) const
+  {
+    return m_nodes.find(node) != m_nodes.end();
+  }
+
+  const std::string* HandleIndex::intern(const std::string& str)
+  {
+    return &*(m_strings.insert(str).first);
+  }
+
+  // Assign keys in (low, high) to nodes in pre-order. Returns false if there are not enough keys.
+  bool HandleIndex::add(const std::vector<SgNode*>& nodes, const std::vector<size_t>& lasts, key_t low, key_t high)
+  {
+    ROSE_ASSERT(nodes.size() == lasts.size());
+    ROSE_ASSERT(low < high);
+    key_t step = (high - low) / (nodes.size() + 1);
+    if (step == 0)
+      return false;
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+      node_entry_t entry;
+      entry.key = low + (i+1)*step;
+      entry.last = low + (lasts[i]+1)*step;
+      entry.line = getStartLine(nodes[i]);
+      entry.file = intern(getNumberingFileName(nodes[i]));
+      entry.name = NULL;
+      addToBuckets(nodes[i], entry);
+      m_nodes[nodes[i]] = entry;
+    }
+    return true;
+  }
+
+  void HandleIndex::addToBuckets(SgNode* node, node_entry_t& entry)
+  {
+    int variant = node->variantT();
+    keyed_node_t item(entry.key, node);
+    insertSorted(m_positions[make_pair(variant, entry.line)], item);
+    insertSorted(m_numberings[make_pair(variant, entry.file)], item);
+    m_variant_files[variant].insert(entry.file);
+    if (m_named_variants.find(variant) != m_named_variants.end())
+    {
+      entry.name = intern(buildroseNode(node)->getName());
+      insertSorted(m_names[make_pair(variant, entry.name)], item);
+    }
+  }
+
+  // Names are only computed for the construct types which are looked up by name, since
+  // roseNode::getName() does not handle all node types.
+  void HandleIndex::indexNames(int variant)
+  {
+    if (!m_named_variants.insert(variant).second)
+      return;
+    const std::set<const std::string*>& files = m_variant_files[variant];
+    for (std::set<const std::string*>::const_iterator f = files.begin(); f != files.end(); f++)
+    {
+      const keyed_nodes_t& nodes = m_numberings[make_pair(variant, *f)];
+      for (keyed_nodes_t::const_iterator i = nodes.begin(); i != nodes.end(); i++)
+      {
+        node_entry_t& entry = m_nodes[i->second];
+        entry.name = intern(buildroseNode(i->second)->getName());
+        insertSorted(m_names[make_pair(variant, entry.name)], *i);
+      }
+    }
+  }
+
+  // the first node in pre-order whose key is in [first, last]
+  SgNode* HandleIndex::findInRange(const keyed_nodes_t& nodes, key_t first, key_t last) const
+  {
+    keyed_nodes_t::const_iterator i = std::lower_bound(nodes.begin(), nodes.end(), keyed_node_t(first, (SgNode*)NULL));
+    if (i != nodes.end() && i->first <= last)
+      return i->second;
+    return NULL;
+  }
+
+  SgNode* HandleIndex::findNode(SgNode* scope, const std::string& construct_type_str, specifier mspecifier)
+  {
+    ROSE_ASSERT(scope != NULL);
+    VariantT vt = getVariantT(construct_type_str);
+    if (vt == V_SgNumVariants)
+      return NULL;
+
+    boost::unordered_map<SgNode*, node_entry_t>::const_iterator s = m_nodes.find(scope);
+    if (s == m_nodes.end())
+    {
+      // not indexed: fall back to searching the subtree
+      abstract_node* result = buildroseNode(scope)->findNode(construct_type_str, mspecifier);
+      return result != NULL ? (SgNode*) result->getNode() : NULL;
+    }
+    key_t first = s->second.key;
+    key_t last = s->second.last;
+
+    switch (mspecifier.get_type())
+    {
+      case e_position:
+        {
+          source_position_pair positions = mspecifier.get_value().positions;
+          boost::unordered_map<std::pair<int, size_t>, keyed_nodes_t>::const_iterator bucket =
+            m_positions.find(make_pair((int)vt, positions.first.line));
+          if (bucket == m_positions.end())
+            return NULL;
+          const keyed_nodes_t& nodes = bucket->second;
+          // the line matches, but columns may still differ
+          for (keyed_nodes_t::const_iterator i = std::lower_bound(nodes.begin(), nodes.end(), keyed_node_t(first, (SgNode*)NULL));
+               i != nodes.end() && i->first <= last; i++)
+          {
+            if (isEqual(positions, buildroseNode(i->second)->getSourcePos()))
+              return i->second;
+          }
+          return NULL;
+        }
+      case e_name:
+        {
+          indexNames(vt);
+          std::set<std::string>::const_iterator name = m_strings.find(mspecifier.get_value().str_v);
+          if (name == m_strings.end())
+            return NULL;
+          boost::unordered_map<std::pair<int, const std::string*>, keyed_nodes_t>::const_iterator bucket =
+            m_names.find(make_pair((int)vt, &*name));
+          if (bucket == m_names.end())
+            return NULL;
+          return findInRange(bucket->second, first, last);
+        }
+      case e_numbering:
+        {
+          // Nodes are numbered among the nodes of the same type from the same file, so the node
+          // with number n is the first in pre-order of the n-th nodes of each file.
+          size_t number = mspecifier.get_value().int_v;
+          if (number == 0)
+            return NULL;
+          keyed_node_t result(0, NULL);
+          const std::set<const std::string*>& files = m_variant_files[vt];
+          for (std::set<const std::string*>::const_iterator f = files.begin(); f != files.end(); f++)
+          {
+            const keyed_nodes_t& nodes = m_numberings[make_pair((int)vt, *f)];
+            keyed_nodes_t::const_iterator begin = std::lower_bound(nodes.begin(), nodes.end(), keyed_node_t(first, (SgNode*)NULL));
+            keyed_nodes_t::const_iterator end = std::lower_bound(begin, nodes.end(), keyed_node_t(last+1, (SgNode*)NULL));
+            if ((size_t)(end - begin) >= number)
+            {
+              const keyed_node_t& candidate = *(begin + (number-1));
+              if (result.second == NULL || candidate.first < result.first)
+                result = candidate;
+            }
+          }
+          return result.second;
+        }
+      default:
+        cerr<<"error: unhandled specifier type in HandleIndex::findNode()"<<endl;
+        ROSE_ASSERT(false);
+    }
+    return NULL;
+  }
+
+  // Resolve a single handle item such as ForStatement<numbering,2> within scope
+  SgNode* HandleIndex::resolve(SgNode* scope, const std::string& handle_item)
+  {
+    std::pair<SgNode*, std::string> cache_key(scope, handle_item);
+    boost::unordered_map<std::pair<SgNode*, std::string>, SgNode*>::const_iterator cached = m_handle_cache.find(cache_key);
+    if (cached != m_handle_cache.end())
+      return cached->second;
+
+    SgNode* result = NULL;
+    string::size_type pos = handle_item.find('<');
+    if (pos != string::npos)
+    {
+      string type_str = handle_item.substr(0, pos);
+      string specifier_str = handle_item.substr(pos, handle_item.find('>', pos) - pos);
+      specifier mspecifier;
+      AbstractHandle::fromString(mspecifier, specifier_str);
+      result = findNode(scope, type_str, mspecifier);
+    }
+    m_handle_cache[cache_key] = result;
+    return result;
+  }
+
+  // Same lookup as abstract_handle::fromString(): all items except the last one are searched
+  // within scope, the last one within the node of the item before it.
+  SgNode* HandleIndex::findNode(SgNode* scope, const std::string& handle_str)
+  {
+    ROSE_ASSERT(scope != NULL);
+    ROSE_ASSERT(handle_str.size()>0);
+    std::vector<string> items;
+    string::size_type begin = 0, end;
+    while ((end = handle_str.find("::", begin)) != string::npos)
+    {
+      items.push_back(handle_str.substr(begin, end - begin));
+      begin = end + 2;
+    }
+    items.push_back(handle_str.substr(begin));
+
+    SgNode* parent = scope;
+    for (size_t i = 0; i+1 < items.size(); i++)
+    {
+      parent = resolve(scope, items[i]);
+      if (parent == NULL)
+        return NULL;
+    }
+    return resolve(parent, items.back());
+  }
+
+  SgNode* HandleIndex::findNode(const std::string& handle_str)
+  {
+    ROSE_ASSERT(m_root != NULL);
+    return findNode(m_root, handle_str);
+  }
+
+  SgLocatedNode* HandleIndex::convertHandleToNode(const std::string& handle_str)
+  {
+    SgProject* project = isSgProject(m_root);
+    if (project == NULL)
+      project = SageInterface::getProject();
+    if (project == NULL)
+      return NULL;
+
+    SgFilePtrList & filelist = project->get_fileList();
+    for (SgFilePtrList::iterator iter = filelist.begin(); iter != filelist.end(); iter++)
+    {
+      SgSourceFile* sfile = isSgSourceFile(*iter);
+      if (sfile != NULL)
+      {
+        SgNode* target_node = findNode(sfile, handle_str);
+        if (target_node != NULL)
+        {
+          ROSE_ASSERT(isSgStatement(target_node));
+          return isSgLocatedNode(target_node);
+        }
+      }
+    }
+    return NULL;
+  }
+
+  // The new subtree gets keys between the last key of the preceding subtree (or its parent)
+  // and the key of the following node in pre-order.
+  void HandleIndex::insert(SgNode* subtree)
+  {
+    ROSE_ASSERT(subtree != NULL);
+    if (m_root == NULL)
+    {
+      build(subtree);
+      return;
+    }
+    if (contains(subtree))
+      erase(subtree);
+    m_handle_cache.clear();
+
+    SgNode* parent = subtree->get_parent();
+    if (parent == NULL || !contains(parent))
+    {
+      build(m_root);
+      return;
+    }
+
+    // the preceding node
+    std::vector<SgNode*> siblings = parent->get_traversalSuccessorContainer();
+    std::vector<SgNode*>::iterator self = std::find(siblings.begin(), siblings.end(), subtree);
+    if (self == siblings.end())
+    {
+      build(m_root);
+      return;
+    }
+    key_t low = m_nodes[parent].key;
+    for (std::vector<SgNode*>::iterator i = self; i != siblings.begin(); )
+    {
+      --i;
+      if (*i != NULL && contains(*i))
+      {
+        low = m_nodes[*i].last;
+        break;
+      }
+    }
+
+    // the following node: the next sibling of the subtree or of one of its ancestors
+    key_t high = std::numeric_limits<key_t>::max();
+    SgNode* child = subtree;
+    for (SgNode* p = parent; p != NULL && contains(p); p = p->get_parent())
+    {
+      bool found = false;
+      std::vector<SgNode*> successors = p->get_traversalSuccessorContainer();
+      std::vector<SgNode*>::iterator i = std::find(successors.begin(), successors.end(), child);
+      if (i != successors.end())
+      {
+        for (++i; i != successors.end(); i++)
+        {
+          if (*i != NULL && contains(*i))
+          {
+            high = m_nodes[*i].key;
+            found = true;
+            break;
+          }
+        }
+      }
+      if (found || p == m_root)
+        break;
+      child = p;
+    }
+
+    PreorderCollector collector;
+    collector.traverse(subtree);
+    if (!add(collector.nodes, collector.lasts, low, high))
+    {
+      // no more keys in this gap
+      build(m_root);
+      return;
+    }
+
+    // the subtree may extend the ranges of its ancestors
+    key_t last = m_nodes[subtree].last;
+    for (SgNode* p = parent; p != NULL && contains(p); p = p->get_parent())
+    {
+      node_entry_t& entry = m_nodes[p];
+      if (entry.last >= last)
+        break;
+      entry.last = last;
+      if (p == m_root)
+        break;
+    }
+  }
+
+  void HandleIndex::erase(SgNode* subtree)
+  {
+    ROSE_ASSERT(subtree != NULL);
+    m_handle_cache.clear();
+    PreorderCollector collector;
+    collector.traverse(subtree);
+    for (std::vector<SgNode*>::iterator n = collector.nodes.begin(); n != collector.nodes.end(); n++)
+    {
+      boost::unordered_map<SgNode*, node_entry_t>::iterator i = m_nodes.find(*n);
+      if (i == m_nodes.end())
+        continue;
+      const node_entry_t& entry = i->second;
+      int variant = (*n)->variantT();
+      keyed_node_t item(entry.key, *n);
+      eraseSorted(m_positions[make_pair(variant, entry.line)], item);
+      eraseSorted(m_numberings[make_pair(variant, entry.file)], item);
+      if (entry.name != NULL)
+        eraseSorted(m_names[make_pair(variant, entry.name)], item);
+      m_nodes.erase(i);
+    }
+    if (subtree == m_root)
+      clear();
+  }
+}
@@ -0,0 +1,111 @@
+#ifndef handle_index_INCLUDED
+#define handle_index_INCLUDED
+
+#include <string>
+#include <vector>
+#include <set>
+#include <utility>
+#include <boost/cstdint.hpp>
+#include <boost/unordered_map.hpp>
+
+#include "abstract_handle.h"
+
+class SgNode;
+class SgLocatedNode;
+
+namespace AbstractHandle
+{
+  //! An index from abstract handle strings and specifiers to AST nodes
+  /*!
+   * roseNode::findNode() resolves a handle item by querying the whole subtree of the scope
+   * and comparing each node of the requested type with the specifier. Resolving many handles
+   * (e.g. all handles of an annotation file) is therefore quadratic in the size of the AST.
+   *
+   * A handle index is built in one AST traversal. Each node gets a key in pre-order, so the
+   * nodes of a subtree are the nodes whose keys are in the range [key(root), last(root)].
+   * Nodes of each type are kept sorted by key, bucketed by start line (position specifiers)
+   * and file name (numbering specifiers). Name specifiers are bucketed by name, computed the
+   * first time a construct type is looked up by name. Resolved handle strings are cached.
+   *
+   * The results are the same as those of roseNode::findNode() and abstract_handle::fromString(),
+   * including the first-match semantics for ambiguous specifiers.
+   *
+   * Keys are spaced apart so that the index can be maintained incrementally when the AST is
+   * transformed: call insert() after attaching a new subtree and erase() before detaching or
+   * deleting one. When a gap runs out of keys the index is rebuilt.
+   *
+   * Example:
+   *   HandleIndex index(project);
+   *   SgNode* node = index.findNode("SourceFile<name,/home/liao6/test.c>::ForStatement<numbering,2>");
+   */
+  class ROSE_DLL_API HandleIndex
+  {
+    public:
+      HandleIndex();
+      //! Build the index for the AST under root
+      explicit HandleIndex(SgNode* root);
+
+      //! (Re)build the index for the AST under root
+      void build(SgNode* root);
+      void clear();
+      SgNode* getRoot() const {return m_root;}
+      //! The number of indexed nodes
+      size_t size() const {return m_nodes.size();}
+      bool contains(SgNode* node) const;
+
+      //! Find a node of a given type matching the specifier within the subtree of scope, like roseNode::findNode()
+      SgNode* findNode(SgNode* scope, const std::string& construct_type_str, specifier mspecifier);
+      //! Find a node from a handle string relative to scope, like abstract_handle(scope_handle, handle_str)
+      SgNode* findNode(SgNode* scope, const std::string& handle_str);
+      //! Find a node from a handle string relative to the root of the index
+      SgNode* findNode(const std::string& handle_str);
+
+      //! Convert a handle string to a located node, trying each source file, like AbstractHandle::convertHandleToNode()
+      SgLocatedNode* convertHandleToNode(const std::string& handle_str);
+
+      //! Add a subtree which has been attached to the indexed AST
+      void insert(SgNode* subtree);
+      //! Remove a subtree which is about to be detached from the indexed AST or deleted
+      void erase(SgNode* subtree);
+
+    private:
+      typedef boost::uint64_t key_t;
+      typedef std::pair<key_t, SgNode*> keyed_node_t;
+      //! nodes sorted by key
+      typedef std::vector<keyed_node_t> keyed_nodes_t;
+
+      struct node_entry_t
+      {
+        key_t key;
+        key_t last; // key of the last node in pre-order within the subtree (or larger)
+        size_t line;
+        const std::string* file;
+        const std::string* name; // NULL until the node's type is indexed by name
+      };
+
+      bool add(const std::vector<SgNode*>& nodes, const std::vector<size_t>& lasts, key_t low, key_t high);
+      void addToBuckets(SgNode* node, node_entry_t& entry);
+      void indexNames(int variant);
+      const std::string* intern(const std::string& str);
+
+      SgNode* findInRange(const keyed_nodes_t& nodes, key_t first, key_t last) const;
+      SgNode* resolve(SgNode* scope, const std::string& handle_item);
+
+      SgNode* m_root;
+      boost::unordered_map<SgNode*, node_entry_t> m_nodes;
+      //! (variant, start line) -> nodes
+      boost::unordered_map<std::pair<int, size_t>, keyed_nodes_t> m_positions;
+      //! (variant, file name) -> nodes
+      boost::unordered_map<std::pair<int, const std::string*>, keyed_nodes_t> m_numberings;
+      //! files with nodes of a variant
+      boost::unordered_map<int, std::set<const std::string*> > m_variant_files;
+      //! (variant, name) -> nodes, only for variants in m_named_variants
+      boost::unordered_map<std::pair<int, const std::string*>, keyed_nodes_t> m_names;
+      std::set<int> m_named_variants;
+      std::set<std::string> m_strings;
+      //! (scope, handle string) -> node
+      boost::unordered_map<std::pair<SgNode*, std::string>, SgNode*> m_handle_cache;
+  };
+}
+
+#endif
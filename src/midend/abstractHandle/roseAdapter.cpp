@@ -4,6 +4,7 @@
 #include <sstream>
 #include <string>
 #include <map>
+#include <boost/unordered_map.hpp>
 
 #include "abstract_handle.h"
 #include "roseAdapter.h"
@@ -15,11 +16,18 @@ using namespace SageInterface;
 
 namespace AbstractHandle
 {
+  static boost::unordered_map<string, int> buildVariantMap()
+  {
+    boost::unordered_map<string, int> variants;
+    for (int i=0; i != V_SgNumVariants; i++)
+      variants.insert(std::make_pair(string(Cxx_GrammarTerminalNames[i].name), i));
+    return variants;
+  }
+
   // A helper function to convert SageType string to its enumerate type.
   // V_SgNumVariants is the last enum value of VariantT, which means no match is found.
-  static VariantT getVariantT(string type_str)
+  VariantT getVariantT(string type_str)
   {
-    int i=0;
     string temp;
     //Assume the simplest conversion: adding 'Sg' is enough
     //Be compatible with both SgStatement and Statement
@@ -28,9 +36,13 @@ namespace AbstractHandle
       temp = "Sg"+type_str;
     else
       temp = type_str; 
-    while (Cxx_GrammarTerminalNames[i].name!=temp && i != V_SgNumVariants)
-      i++;
-    return (VariantT)i;  
+    // The names are looked up for every handle item, so they are hashed once, on first use
+    // (Cxx_GrammarTerminalNames may not be initialized yet during static initialization).
+    static const boost::unordered_map<string, int> variantMap = buildVariantMap();
+    boost::unordered_map<string, int>::const_iterator i = variantMap.find(temp);
+    if (i == variantMap.end())
+      return V_SgNumVariants;
+    return (VariantT)i->second;
   }
   // test LDADD dependency
   roseNode* buildroseNode(SgNode* snode)
@@ -41,6 +41,9 @@ namespace AbstractHandle
   //! A default builder function handles all details: file use name, others use numbering  
   ROSE_DLL_API abstract_handle * buildAbstractHandle(SgNode* snode);
 
+  //! Convert a construct type name (with or without the Sg prefix) to a ROSE variant, V_SgNumVariants if there is no match
+  ROSE_DLL_API VariantT getVariantT(std::string type_str);
+
   //! Convert an abstract handle string to a located node in AST
   ROSE_DLL_API SgLocatedNode* convertHandleToNode(const std::string& handle);
 }
@@ -8,6 +8,8 @@
 
 #include <limits>
 #include <set>
+#include <boost/range/iterator_range.hpp>
+#include <boost/unordered_map.hpp>
 #include "RoseAst.h"
 #include "VariableIdMapping.h"
 
@@ -132,6 +134,63 @@ class LabelSet : public std::set<Label> {
 
 typedef std::set<LabelSet> LabelSetSet;
 
+/*! 
+  * Set of labels represented as a bit vector indexed by the label id.
+  * Insertion, removal, and membership tests take constant time, and
+  * iteration is in ascending label order (as for LabelSet). The memory
+  * is proportional to the largest label id in the set, therefore this
+  * representation is meant for sets that range over a large part of
+  * the labels of a program (e.g. visited sets of graph traversals).
+  * Small sets are better represented by LabelSet.
+ */
+class DenseLabelSet {
+ public:
+  class iterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Label value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const Label* pointer;
+    typedef Label reference;
+    iterator();
+    iterator(const DenseLabelSet* set, size_t labelId);
+    Label operator*() const;
+    iterator& operator++();
+    iterator operator++(int);
+    bool operator==(const iterator& other) const;
+    bool operator!=(const iterator& other) const;
+  private:
+    const DenseLabelSet* _set;
+    size_t _labelId;
+  };
+  typedef iterator const_iterator;
+
+  DenseLabelSet();
+  // reserves space for labels 0..numLabels-1 (the set grows on demand)
+  DenseLabelSet(size_t numLabels);
+  // returns true if the label was not an element of the set before
+  bool insert(Label lab);
+  // returns the number of removed elements (0 or 1)
+  size_t erase(Label lab);
+  bool isElement(Label lab) const;
+  size_t size() const;
+  bool empty() const;
+  void clear();
+  iterator begin() const;
+  iterator end() const;
+  DenseLabelSet& operator+=(const DenseLabelSet& s2);
+  LabelSet toLabelSet() const;
+  std::string toString() const;
+ private:
+  // returns the first label id >= labelId that is an element, or the end id
+  size_t findNext(size_t labelId) const;
+  size_t endId() const;
+  typedef unsigned long long Word;
+  static const size_t bitsPerWord=8*sizeof(Word);
+  std::vector<Word> _words;
+  size_t _size;
+};
+
 /*! 
   * \author Markus Schordan
   * \date 2012, 2013.
@@ -140,10 +199,20 @@ class Labeler {
  public:
   Labeler();
   static Label NO_LABEL; // default initialized label (used to check for non-existing labels)
-  Labeler(SgNode* start);
+  /** The function definitions in 'start' are labeled by 'numberOfThreads' threads
+      (0 means the hardware concurrency). The numbering does not depend on the number of threads.
+  */
+  Labeler(SgNode* start, size_t numberOfThreads=1);
   static std::string labelToString(Label lab);
   int isLabelRelevantNode(SgNode* node);
+  /** Labels are assigned in pre-order of the AST. The labels of a function definition are
+      created independently of those of other function definitions (in parallel if the number
+      of threads is greater than 1) and then spliced in at the function definition's position.
+      Replaces all existing labels and function label ranges.
+  */
   virtual void createLabels(SgNode* node);
+  void setNumberOfThreads(size_t numberOfThreads);
+  size_t getNumberOfThreads();
 
   /** Labels are numbered 0..n-1 where n is the number of labels
       associated with AST nodes (not all nodes are labeled, and some
@@ -199,21 +268,35 @@ class Labeler {
   };
   iterator begin();
   iterator end();
+
+  /** The labels of a function definition are contiguous. The range starts with the
+      function's entry label and contains the exit label, the labels of the function's body,
+      and the labels of all functions defined inside of it (e.g. member functions of local classes).
+      Returns an empty range if 'entryLabel' is not a function entry label.
+  */
+  typedef boost::iterator_range<Labeler::iterator> LabelRange;
+  LabelRange functionLabels(Label entryLabel);
+  LabelRange functionLabels(SgFunctionDefinition* funDef);
+  // returns true if label 'lab' is in the label range of the function with entry label 'entryLabel' (O(1)).
+  bool isFunctionLabel(Label lab, Label entryLabel);
   virtual ~Labeler();
  protected:
   void computeNodeToLabelMapping();
-  void registerLabel(LabelProperty);
   typedef std::vector<LabelProperty> LabelToLabelPropertyMapping;
   LabelToLabelPropertyMapping mappingLabelToLabelProperty;
-  typedef std::map<SgNode*,Label> NodeToLabelMapping;
+  typedef boost::unordered_map<SgNode*,Label> NodeToLabelMapping;
   NodeToLabelMapping mappingNodeToLabel;
   bool _isValidMappingNodeToLabel;
   void ensureValidNodeToLabelMapping();
+  // maps the id of a function entry label to the id one past the function's last label
+  typedef boost::unordered_map<size_t,size_t> FunctionLabelRangeMapping;
+  FunctionLabelRangeMapping mappingFunctionEntryToLabelRangeEnd;
+  size_t _numberOfThreads;
 };
 
 class IOLabeler : public Labeler {
  public:
-  IOLabeler(SgNode* start, VariableIdMapping* variableIdMapping);
+  IOLabeler(SgNode* start, VariableIdMapping* variableIdMapping, size_t numberOfThreads=1);
   virtual bool isStdIOLabel(Label label);
   virtual bool isStdInLabel(Label label, VariableId* id=0);
   virtual bool isStdOutLabel(Label label); 
@@ -648,6 +648,7 @@ class ROSE_DLL_API HighLevelInterfaceNodeCollection : public AbstractInterfaceNo
 typedef MidLevelRewrite<MidLevelInterfaceNodeCollection> MiddleLevelRewrite;
 
 #include "highLevelRewriteInterface.h"
+#include "rewriteTransaction.h"
 
 #if 0
 class SAGE_Rewrite
@@ -0,0 +1,98 @@
+#ifndef AST_REWRITE_TRANSACTION_H
+#define AST_REWRITE_TRANSACTION_H
+
+// A rewrite transaction queues string based edits (as accepted by the MidLevelRewrite interface)
+// and applies them all when committed.  The MidLevelRewrite::insert() function compiles each
+// transformation string by generating an intermediate file and running the frontend on it, and
+// then inserts the new statements with the SageInterface functions, which fix up parents, scopes
+// and symbol tables on every call.  A transaction instead:
+//    1) compiles all transformation strings for a file in one intermediate file (one frontend call),
+//    2) splices the new statements into each statement list (SgBasicBlock or SgGlobal) in one pass,
+//       removing the symbols of replaced and removed declarations from the list's symbol table, and
+//    3) once all statement lists are rebuilt, fixes up parents, scopes, symbols and types of each
+//       inserted statement (using SageBuilder::fixupCopyOfAstFromSeparateFileInNewTargetAst(), as
+//       for AST snippets, which is called once per inserted statement), and then rebinds variable
+//       and function references elsewhere in the file from the symbols of replaced declarations to
+//       the symbols of the declarations that replace them.
+//
+// Restrictions:
+//    - Only C and C++ are supported (as with the intermediate files of the rest of this mechanism).
+//    - Targets must be statements in a SgBasicBlock or declarations in a SgGlobal.
+//    - Each target can be replaced or removed at most once, and targets must not be within
+//      statements that the same transaction replaces or removes.
+//    - All strings for a file are compiled with the global declarations that precede the last
+//      target in the file, so a string must not declare a global name that the file declares later.
+//
+// Example:
+//    RewriteTransaction transaction;
+//    transaction.insert(statement1,"x = 0;");
+//    transaction.insert(statement2,"x++;",MidLevelCollectionTypedefs::AfterCurrentPosition);
+//    transaction.replace(statement3,"y = x;");
+//    SgStatementPtrList replaced = transaction.commit();
+//    for (size_t i = 0; i < replaced.size(); i++)
+//         SageInterface::deleteAST(replaced[i]);
+
+class ROSE_DLL_API RewriteTransaction
+   {
+  // Interface classification:
+  //      Permits String Based Specification of Transformation: YES
+  //      Permits Relative Specification of Target: NO
+  //      Contains State information: YES
+
+     public:
+          typedef MidLevelCollectionTypedefs::PlacementPositionEnum PlacementPositionEnum;
+
+       // A queued edit (location is normalized to before, replace or after the target).
+          class Edit
+             {
+               public:
+                    SgStatement* target;
+                    std::string transformationString;
+                    PlacementPositionEnum location;
+
+                 // Statements compiled from the transformation string (in the intermediate file's AST).
+                    SgStatementPtrList fragment;
+
+                    Edit ( SgStatement* target, const std::string & transformationString, PlacementPositionEnum location );
+             };
+
+          RewriteTransaction();
+         ~RewriteTransaction();
+
+      //! Queue insertion of a transformation string relative to the target statement
+      /*! TopOfCurrentScope and BottomOfCurrentScope require the target to be a SgBasicBlock or
+          SgGlobal; the other locations require it to be a statement in one.
+       */
+          void insert ( SgStatement* target,
+                        const std::string & transformationString,
+                        PlacementPositionEnum locationInScope = MidLevelCollectionTypedefs::BeforeCurrentPosition );
+
+      //! Queue replacement of the target statement by a transformation string
+          void replace ( SgStatement* target, const std::string & transformationString );
+
+      //! Queue removal of the target statement
+          void remove  ( SgStatement* target );
+
+      //! Number of queued edits
+          size_t numberOfEdits() const;
+          bool isEmpty() const;
+
+      //! Discard all queued edits
+          void rollback();
+
+      //! Apply all queued edits (the transaction is empty afterward)
+      /*! Returns the replaced and removed statements.  They are no longer in the AST and their
+          symbols are removed from the symbol tables.  References elsewhere in the AST are rebound
+          to the symbol of a replacing declaration with the same name; the symbol of a removed
+          declaration that is still referenced is kept in its symbol table.  The symbols are never
+          deleted.  The caller owns the returned statements and should delete them (e.g. with
+          SageInterface::deleteAST()) once nothing refers to them.
+       */
+          SgStatementPtrList commit();
+
+     private:
+          std::vector<Edit> edits;
+   };
+
+// endif for AST_REWRITE_TRANSACTION_H
+#endif
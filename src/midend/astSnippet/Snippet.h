@@ -85,6 +85,46 @@ public:
      *  null. No attempt is made to determine whether unequal names resolve to the same file. */
     static SnippetFilePtr lookup(const std::string &fileName);
 
+    /** Write a precompiled snippet library.
+     *
+     *  Parsing snippet files is usually much slower than the rest of a snippet insertion tool, and the same snippet files are
+     *  parsed again for every specimen. A precompiled library avoids that: a small tool parses the snippet files once with
+     *  frontend(), and calls this method to write the resulting AST with AST_FILE_IO.  Every source file of the @p project is
+     *  treated as a snippet file and is marked so it is never unparsed.  Throws an std::runtime_error if the project has no
+     *  source files.
+     *
+     *  Since AST_FILE_IO writes the memory pools rather than a subtree, the project should contain nothing else. Note that a
+     *  library can only be loaded by a tool that has not created any AST yet; see @ref loadLibrary.
+     *
+     * @code
+     *  SgProject *project = frontend(argc, argv); // argv names the snippet files
+     *  SnippetFile::saveLibrary(project, "snippets.ast");
+     * @endcode */
+    static void saveLibrary(SgProject *project, const std::string &libraryName);
+
+    /** Load a precompiled snippet library.
+     *
+     *  <b>Restriction:</b> this must be the first AST the tool creates. AST_FILE_IO can only combine ASTs that were all read
+     *  from files, so loadLibrary cannot be called after frontend() or after any other AST has been built; it throws
+     *  std::runtime_error in that case. A tool that uses a library therefore adds its specimen to the library's project
+     *  afterward (see below) instead of parsing it with frontend() first.
+     *
+     *  Reads a library written by @ref saveLibrary and registers a SnippetFile for each of its source files as if instance()
+     *  had parsed it. The files are registered under their names with path (SgFile::get_sourceFileNameWithPath), which is the
+     *  name to pass to instance(), lookup(), or Snippet::instanceFromFile(); the source files need not exist.  Files that are
+     *  already registered are not replaced.  Returns the SnippetFile objects for the library's files in the order they appear
+     *  in the library.
+     *
+     *  The library's SgProject becomes the project, and the specimen is added to it, for instance with SageBuilder::buildFile(), which is also how snippet files are parsed when there is no
+     *  library.
+     *
+     * @code
+     *  SnippetFile::loadLibrary("snippets.ast");
+     *  SgSourceFile *specimen = isSgSourceFile(SageBuilder::buildFile("specimen.c", "rose_specimen.c",
+     *                                                                 SageInterface::getProject()));
+     * @endcode */
+    static std::vector<SnippetFilePtr> loadLibrary(const std::string &libraryName);
+
     /** Returns the name of the file. This is the same name given to the instance() constructor. */
     const std::string& getName() const { return fileName; }
 
@@ -0,0 +1,213 @@
+#ifndef ROSE_EditDistance_SubtreeMatcher_H
+#define ROSE_EditDistance_SubtreeMatcher_H
+
+#include <EditDistance/TreeEditDistance.h>
+
+#include <boost/cstdint.hpp>
+#include <vector>
+
+namespace Rose {
+namespace EditDistance {
+namespace TreeEditDistance {
+
+/** Finds similar subtrees without comparing every pair.
+ *
+ *  Computing the tree edit distance for one pair of trees takes time proportional to the product of their sizes (see @ref
+ *  Analysis::compute), so comparing every subtree of one AST with every subtree of another, as is done when looking for
+ *  clones, is prohibitively expensive for all but the smallest inputs.  This matcher works in two phases:
+ *
+ *  @li Each subtree is summarized by a @ref Fingerprint. A fingerprint contains a structural hash of the whole subtree (two
+ *      subtrees have the same hash when they have the same shape and node types, much like @ref
+ *      Rose::BinaryAnalysis::AstHash), and a MinHash signature of the multiset of the subtree's parent/child node-type
+ *      patterns.  Pairs with equal structural hashes whose trees are verified to be identical have a similarity of one, and
+ *      their edit distance follows from the edit costs in linear time (unless the substitution predicate forbids some
+ *      substitution between them, in which case they are compared like any other pair).  For the remaining pairs,
+ *      locality-sensitive hashing over bands of the signatures places similar subtrees in the same bucket, and only subtrees
+ *      that share a bucket become candidate pairs.
+ *
+ *  @li The candidate pairs whose estimated similarity (the fraction of equal MinHash values, an estimate of the Jaccard
+ *      similarity of the patterns) is at least @ref minSimilarity are compared with the exact tree edit distance @ref
+ *      Analysis. The comparisons are independent of one another and run in parallel.
+ *
+ *  The first phase may miss pairs that are similar (the probability of that is low when the similarity is well above the
+ *  threshold), but never reports a distance that was not computed exactly.
+ *
+ *  Example usage:
+ *
+ * @code
+ *  using namespace Rose::EditDistance;
+ *  TreeEditDistance::SubtreeMatcher matcher;
+ *  matcher.analysis().substitutionCost(0.0);
+ *  matcher.minSimilarity(0.8).nThreads(0);
+ *  TreeEditDistance::SubtreeMatcher::Matches matches = matcher.compute(functions1, functions2);
+ * @endcode */
+class SubtreeMatcher {
+public:
+    /** Summary of one subtree. */
+    struct Fingerprint {
+        SgNode *root;                                   /**< Root of the subtree. */
+        boost::uint64_t structuralHash;                 /**< Hash of the subtree's shape and node types. */
+        size_t nNodes;                                  /**< Number of nodes in the subtree. */
+        std::vector<boost::uint64_t> signature;         /**< MinHash signature. */
+
+        Fingerprint()
+            : root(NULL), structuralHash(0), nNodes(0) {}
+    };
+
+    /** Result for one pair of subtrees. */
+    struct Match {
+        SgNode *source;                                 /**< Subtree from the source list. */
+        SgNode *target;                                 /**< Subtree from the target list. */
+        double similarity;                              /**< Estimated similarity from the fingerprints. */
+        double cost;                                    /**< Exact edit distance, @ref Analysis::cost. */
+        double relativeCost;                            /**< Exact relative edit distance, @ref Analysis::relativeCost. */
+
+        Match()
+            : source(NULL), target(NULL), similarity(0.0), cost(0.0), relativeCost(0.0) {}
+        Match(SgNode *source, SgNode *target, double similarity)
+            : source(source), target(target), similarity(similarity), cost(0.0), relativeCost(0.0) {}
+    };
+
+    /** List of results. */
+    typedef std::vector<Match> Matches;
+
+    /** Statistics from the most recent call to @ref compute or @ref computeSubtrees. */
+    struct Stats {
+        size_t nPairs;                                  /**< Number of source/target pairs that were eligible. */
+        size_t nCandidates;                             /**< Number of pairs that shared an LSH bucket, excluding exact ones. */
+        size_t nExact;                                  /**< Number of identical pairs whose distance was not computed. */
+        size_t nComputed;                               /**< Number of pairs whose exact edit distance was computed. */
+
+        Stats()
+            : nPairs(0), nCandidates(0), nExact(0), nComputed(0) {}
+    };
+
+private:
+    Analysis analysis_;                                 // settings for the exact edit distance
+    size_t nBands_;                                     // number of LSH bands
+    size_t bandSize_;                                   // number of MinHash values per band
+    double minSimilarity_;                              // threshold for computing the exact distance
+    size_t minNodes_;                                   // smallest subtree considered by computeSubtrees
+    size_t nThreads_;                                   // number of worker threads; zero means hardware concurrency
+    Stats stats_;
+
+public:
+    /** Construct a matcher with default settings. */
+    SubtreeMatcher()
+        : nBands_(16), bandSize_(4), minSimilarity_(0.5), minNodes_(10), nThreads_(1) {}
+
+    /** Property: exact analysis settings.
+     *
+     *  The edit costs and substitution predicate used for the exact comparisons. Each comparison is made with a copy of this
+     *  analysis, so a substitution predicate must be thread safe if @ref nThreads is other than one.
+     *
+     * @{ */
+    const Analysis& analysis() const {
+        return analysis_;
+    }
+    Analysis& analysis() {
+        return analysis_;
+    }
+    /** @} */
+
+    /** Property: locality-sensitive hashing bands.
+     *
+     *  The MinHash signature has <code>nBands * bandSize</code> values which are divided into bands. Two subtrees become
+     *  candidates when all values in at least one band are equal.  The probability that a pair with similarity @em s becomes
+     *  a candidate is \f$1-(1-s^r)^b\f$ where @em b is the number of bands and @em r is the band size. The defaults, 16 bands
+     *  of 4, find most pairs whose similarity is above 0.5.
+     *
+     * @{ */
+    size_t nBands() const {
+        return nBands_;
+    }
+    SubtreeMatcher& nBands(size_t n) {
+        ASSERT_require(n > 0);
+        nBands_ = n;
+        return *this;
+    }
+    size_t bandSize() const {
+        return bandSize_;
+    }
+    SubtreeMatcher& bandSize(size_t n) {
+        ASSERT_require(n > 0);
+        bandSize_ = n;
+        return *this;
+    }
+    /** @} */
+
+    /** Property: minimum similarity.
+     *
+     *  Candidates whose estimated similarity is less than this value, or whose sizes differ by more than this ratio, are
+     *  discarded without computing their exact edit distance.
+     *
+     * @{ */
+    double minSimilarity() const {
+        return minSimilarity_;
+    }
+    SubtreeMatcher& minSimilarity(double s) {
+        ASSERT_require(s >= 0.0 && s <= 1.0);
+        minSimilarity_ = s;
+        return *this;
+    }
+    /** @} */
+
+    /** Property: minimum subtree size.
+     *
+     *  Subtrees with fewer nodes than this are not considered by @ref computeSubtrees.
+     *
+     * @{ */
+    size_t minNodes() const {
+        return minNodes_;
+    }
+    SubtreeMatcher& minNodes(size_t n) {
+        minNodes_ = n;
+        return *this;
+    }
+    /** @} */
+
+    /** Property: number of threads.
+     *
+     *  Number of threads used for the exact comparisons. Zero means use the hardware concurrency.
+     *
+     * @{ */
+    size_t nThreads() const {
+        return nThreads_;
+    }
+    SubtreeMatcher& nThreads(size_t n) {
+        nThreads_ = n;
+        return *this;
+    }
+    /** @} */
+
+    /** Statistics from the most recent comparison. */
+    const Stats& stats() const {
+        return stats_;
+    }
+
+    /** Compute the fingerprint for one subtree. */
+    Fingerprint fingerprint(SgNode *root) const;
+
+    /** Compare subtrees from two lists.
+     *
+     *  Returns the exact edit distances for the pairs (source, target) that pass both phases, ordered by source and then by
+     *  target according to their positions in the lists.  If the two lists are the same list, then each unordered pair is
+     *  compared only once and subtrees are not compared with themselves or with their own ancestors or descendants. */
+    Matches compute(const std::vector<SgNode*> &sources, const std::vector<SgNode*> &targets);
+
+    /** Compare all subtrees of two trees.
+     *
+     *  Like @ref compute, but the lists are every subtree of @p source and @p target that has at least @ref minNodes nodes.
+     *  If @p source and @p target are the same tree then this finds clones within that tree. */
+    Matches computeSubtrees(SgNode *source, SgNode *target);
+
+private:
+    std::vector<Fingerprint> fingerprints(const std::vector<SgNode*>&) const;
+    Matches match(const std::vector<Fingerprint> &sources, const std::vector<Fingerprint> &targets, bool sameList);
+};
+
+} // namespace
+} // namespace
+} // namespace
+
+#endif